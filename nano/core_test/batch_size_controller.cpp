@@ -0,0 +1,62 @@
+#include <nano/lib/batch_size_controller.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST (batch_size_controller, construction)
+{
+	nano::batch_size_controller controller{ 100ms, 16, 1024, 256 };
+	ASSERT_EQ (256, controller.size ());
+}
+
+TEST (batch_size_controller, initial_clamped)
+{
+	nano::batch_size_controller controller{ 100ms, 16, 1024, 4096 };
+	ASSERT_EQ (1024, controller.size ());
+}
+
+TEST (batch_size_controller, keep_near_target)
+{
+	nano::batch_size_controller controller{ 100ms, 16, 1024, 256 };
+	ASSERT_EQ (nano::batch_size_controller::decision::keep, controller.update (256, 90ms));
+	ASSERT_EQ (nano::batch_size_controller::decision::keep, controller.update (256, 110ms));
+	ASSERT_EQ (256, controller.size ());
+}
+
+TEST (batch_size_controller, increase)
+{
+	nano::batch_size_controller controller{ 100ms, 16, 1024, 256 };
+	ASSERT_EQ (nano::batch_size_controller::decision::increase, controller.update (256, 50ms));
+	ASSERT_EQ (512, controller.size ());
+	// Growth is limited to doubling per step
+	ASSERT_EQ (nano::batch_size_controller::decision::increase, controller.update (512, 1ms));
+	ASSERT_EQ (1024, controller.size ());
+	// Capped at maximum
+	ASSERT_EQ (nano::batch_size_controller::decision::keep, controller.update (1024, 1ms));
+	ASSERT_EQ (1024, controller.size ());
+}
+
+TEST (batch_size_controller, partial_batch_no_increase)
+{
+	nano::batch_size_controller controller{ 100ms, 16, 1024, 256 };
+	ASSERT_EQ (nano::batch_size_controller::decision::keep, controller.update (10, 1ms));
+	ASSERT_EQ (256, controller.size ());
+}
+
+TEST (batch_size_controller, decrease)
+{
+	nano::batch_size_controller controller{ 100ms, 16, 1024, 256 };
+	ASSERT_EQ (nano::batch_size_controller::decision::decrease, controller.update (256, 160ms));
+	ASSERT_EQ (160, controller.size ());
+	// Shrinking is limited to halving per step
+	ASSERT_EQ (nano::batch_size_controller::decision::decrease, controller.update (160, 10s));
+	ASSERT_EQ (80, controller.size ());
+}
+
+TEST (batch_size_controller, minimum)
+{
+	nano::batch_size_controller controller{ 100ms, 16, 1024, 16 };
+	ASSERT_EQ (nano::batch_size_controller::decision::keep, controller.update (16, 10s));
+	ASSERT_EQ (16, controller.size ());
+}
@@ -0,0 +1,167 @@
+#include <nano/lib/blockbuilders.hpp>
+#include <nano/lib/blocks.hpp>
+#include <nano/secure/block_cache.hpp>
+#include <nano/secure/common.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/secure/ledger_set_any.hpp>
+#include <nano/store/block.hpp>
+#include <nano/test_common/ledger.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::shared_ptr<nano::block> make_block (nano::uint128_t balance)
+{
+	nano::block_builder builder;
+	return builder.state ()
+	.make_block ()
+	.account (nano::dev::genesis_key.pub)
+	.previous (nano::dev::genesis->hash ())
+	.representative (nano::dev::genesis_key.pub)
+	.balance (balance)
+	.link (nano::dev::genesis_key.pub)
+	.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+	.work (0)
+	.build ();
+}
+
+auto const always_valid = [] (nano::block const &) { return true; };
+}
+
+TEST (block_cache, empty)
+{
+	nano::block_cache cache;
+	ASSERT_TRUE (cache.enabled ());
+	ASSERT_EQ (0, cache.size ());
+	ASSERT_EQ (nullptr, cache.get (nano::dev::genesis->hash (), always_valid));
+}
+
+TEST (block_cache, put_get)
+{
+	nano::block_cache cache;
+	auto block = make_block (1);
+	cache.put (block);
+	ASSERT_EQ (1, cache.size ());
+	ASSERT_EQ (block, cache.get (block->hash (), always_valid));
+}
+
+TEST (block_cache, erase)
+{
+	nano::block_cache cache;
+	auto block = make_block (1);
+	cache.put (block);
+	cache.erase (block->hash ());
+	ASSERT_EQ (0, cache.size ());
+	ASSERT_EQ (nullptr, cache.get (block->hash (), always_valid));
+}
+
+TEST (block_cache, invalid_removed)
+{
+	nano::block_cache cache;
+	auto block = make_block (1);
+	cache.put (block);
+	ASSERT_EQ (nullptr, cache.get (block->hash (), [] (nano::block const &) { return false; }));
+	ASSERT_EQ (0, cache.size ());
+}
+
+TEST (block_cache, capacity)
+{
+	nano::block_cache cache{ nano::block_cache::shard_count * 2 };
+	for (auto i = 1; i <= 1000; ++i)
+	{
+		cache.put (make_block (i));
+	}
+	ASSERT_EQ (nano::block_cache::shard_count * 2, cache.size ());
+}
+
+TEST (block_cache, disabled)
+{
+	nano::block_cache cache{ 0 };
+	ASSERT_FALSE (cache.enabled ());
+	auto block = make_block (1);
+	cache.put (block);
+	ASSERT_EQ (0, cache.size ());
+	ASSERT_EQ (nullptr, cache.get (block->hash (), always_valid));
+}
+
+TEST (block_cache, generation)
+{
+	nano::block_cache cache;
+	auto block = make_block (1);
+	auto other = make_block (2);
+	auto const generation = cache.generation ();
+	cache.erase (block->hash ());
+	ASSERT_LT (generation, cache.generation ());
+	// A copy read from a snapshot opened before the invalidation is not inserted
+	cache.put (block, generation);
+	ASSERT_EQ (0, cache.size ());
+	cache.put (block, cache.generation ());
+	ASSERT_EQ (1, cache.size ());
+	// Blocks that were not invalidated are inserted from older snapshots
+	cache.put (other, generation);
+	ASSERT_EQ (2, cache.size ());
+}
+
+TEST (block_cache, ledger_rollback)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	auto & ledger = ctx.ledger ();
+	auto send = ctx.blocks ()[0];
+	auto receive = ctx.blocks ()[1];
+	{
+		auto transaction = ledger.tx_begin_read ();
+		auto block = ledger.any.block_get (transaction, send->hash ());
+		ASSERT_NE (nullptr, block);
+		ASSERT_EQ (receive->hash (), block->sideband ().successor);
+		ASSERT_NE (nullptr, ledger.any.block_get (transaction, receive->hash ()));
+		// Served from the cache
+		ASSERT_EQ (block, ledger.any.block_get (transaction, send->hash ()));
+	}
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_FALSE (ledger.rollback (transaction, receive->hash ()));
+		ASSERT_EQ (nullptr, ledger.any.block_get (transaction, receive->hash ()));
+		auto block = ledger.any.block_get (transaction, send->hash ());
+		ASSERT_NE (nullptr, block);
+		ASSERT_TRUE (block->sideband ().successor.is_zero ());
+	}
+}
+
+TEST (block_cache, ledger_stale_entry)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	auto & ledger = ctx.ledger ();
+	auto send = ctx.blocks ()[0];
+	auto receive = ctx.blocks ()[1];
+	{
+		auto transaction = ledger.tx_begin_read ();
+		ASSERT_NE (nullptr, ledger.any.block_get (transaction, send->hash ()));
+	}
+	// Modifying the store directly bypasses invalidation, the cached entry must be detected as stale
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ledger.store.block.successor_clear (transaction, send->hash ());
+		auto block = ledger.any.block_get (transaction, send->hash ());
+		ASSERT_NE (nullptr, block);
+		ASSERT_TRUE (block->sideband ().successor.is_zero ());
+	}
+}
+
+// A reader whose snapshot predates a rollback must not restore the rolled back block into the cache
+TEST (block_cache, ledger_rollback_old_snapshot)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	auto & ledger = ctx.ledger ();
+	auto receive = ctx.blocks ()[1];
+	auto snapshot = ledger.tx_begin_read ();
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_FALSE (ledger.rollback (transaction, receive->hash ()));
+	}
+	auto const size = ledger.block_cache.size ();
+	ASSERT_NE (nullptr, ledger.any.block_get (snapshot, receive->hash ()));
+	ASSERT_EQ (size, ledger.block_cache.size ());
+	snapshot.refresh ();
+	ASSERT_EQ (nullptr, ledger.any.block_get (snapshot, receive->hash ()));
+}
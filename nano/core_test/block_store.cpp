@@ -134,6 +134,40 @@ TEST (block_store, add_item)
 	ASSERT_EQ (nullptr, latest3);
 }
 
+TEST (block_store, serialized_get)
+{
+	nano::logger logger;
+	auto store = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	nano::block_builder builder;
+	auto block = builder
+				 .open ()
+				 .source (0)
+				 .representative (1)
+				 .account (0)
+				 .sign (nano::keypair ().prv, 0)
+				 .work (0)
+				 .build ();
+	nano::block_sideband sideband{};
+	sideband.successor = 42;
+	block->sideband_set (sideband);
+	auto transaction (store->tx_begin_write ());
+	std::vector<uint8_t> buffer{ 0xff };
+	ASSERT_FALSE (store->block.serialized_get (transaction, block->hash (), buffer));
+	ASSERT_EQ (1, buffer.size ());
+	store->block.put (transaction, block->hash (), *block);
+	auto successor = store->block.serialized_get (transaction, block->hash (), buffer);
+	ASSERT_TRUE (successor);
+	ASSERT_EQ (42, *successor);
+	// Appended bytes are the network serialization of the block
+	std::vector<uint8_t> expected{ 0xff };
+	{
+		nano::vectorstream stream{ expected };
+		nano::serialize_block (stream, *block);
+	}
+	ASSERT_EQ (expected, buffer);
+}
+
 TEST (block_store, clear_successor)
 {
 	nano::logger logger;
@@ -890,6 +924,46 @@ TEST (block_store, account_count)
 	ASSERT_EQ (1, store->account.count (transaction));
 }
 
+TEST (block_store, account_for_each_range)
+{
+	nano::logger logger;
+	auto store = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	{
+		auto transaction (store->tx_begin_write ());
+		for (auto i = 1; i <= 5; ++i)
+		{
+			nano::account_info info;
+			info.block_count = i;
+			store->account.put (transaction, nano::account (i * 10), info);
+		}
+	}
+	auto transaction (store->tx_begin_read ());
+	std::vector<std::pair<nano::account, uint64_t>> visited;
+	auto visitor = [&visited] (nano::account const & account, nano::account_info const & info) {
+		visited.emplace_back (account, info.block_count);
+		return true;
+	};
+	// [from, to) is half open
+	store->account.for_each_range (transaction, 15, 40, visitor);
+	ASSERT_EQ (2, visited.size ());
+	ASSERT_EQ (nano::account (20), visited[0].first);
+	ASSERT_EQ (2, visited[0].second);
+	ASSERT_EQ (nano::account (30), visited[1].first);
+	// A zero upper bound reads to the end
+	visited.clear ();
+	store->account.for_each_range (transaction, 40, 0, visitor);
+	ASSERT_EQ (2, visited.size ());
+	ASSERT_EQ (nano::account (50), visited[1].first);
+	// Returning false stops the scan
+	visited.clear ();
+	store->account.for_each_range (transaction, 0, 0, [&visited] (nano::account const & account, nano::account_info const & info) {
+		visited.emplace_back (account, info.block_count);
+		return visited.size () < 3;
+	});
+	ASSERT_EQ (3, visited.size ());
+}
+
 TEST (block_store, cemented_count_cache)
 {
 	nano::logger logger;
@@ -1761,3 +1835,46 @@ TEST (rocksdb_block_store, tombstone_count)
 	ASSERT_TIMELY_EQ (5s, store->tombstone_map.at (nano::tables::accounts).num_since_last_flush.load (), 1);
 }
 }
+
+TEST (write_queue, single_writer)
+{
+	nano::test::system system;
+	nano::store::write_queue queue{ false };
+	auto guard = queue.wait (nano::store::writer::blockprocessor, { nano::tables::accounts, nano::tables::blocks });
+	std::atomic<bool> acquired{ false };
+	std::thread thread ([&] () {
+		auto votes = queue.wait (nano::store::writer::voting_final, { nano::tables::final_votes });
+		acquired = true;
+	});
+	// Tables are ignored, every writer waits for the head of the queue
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::voting_final));
+	ASSERT_NEVER (100ms, acquired);
+	guard.release ();
+	thread.join ();
+	ASSERT_TRUE (acquired);
+}
+
+TEST (write_queue, table_scoped)
+{
+	nano::test::system system;
+	nano::store::write_queue queue{ false, true };
+	auto blocks = queue.wait (nano::store::writer::blockprocessor, { nano::tables::accounts, nano::tables::blocks });
+	// Disjoint tables are granted while the first writer holds its guard
+	auto votes = queue.wait (nano::store::writer::voting_final, { nano::tables::final_votes });
+	ASSERT_TRUE (votes.is_owned ());
+	std::atomic<bool> acquired{ false };
+	std::thread thread ([&] () {
+		auto pruning = queue.wait (nano::store::writer::pruning, { nano::tables::blocks, nano::tables::pruned });
+		acquired = true;
+	});
+	// Overlapping tables wait for the holder
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::pruning));
+	ASSERT_NEVER (100ms, acquired);
+	blocks.release ();
+	thread.join ();
+	ASSERT_TRUE (acquired);
+	// No tables conflicts with every writer
+	votes.release ();
+	auto all = queue.wait (nano::store::writer::testing);
+	ASSERT_TRUE (all.is_owned ());
+}
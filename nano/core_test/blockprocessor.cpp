@@ -40,3 +40,47 @@ TEST (block_processor, broadcast_block_on_arrival)
 	// Checks whether the block was broadcast.
 	ASSERT_TIMELY (5s, node2->block_or_pruned_exists (send1->hash ()));
 }
+
+TEST (block_processor, pipeline)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.block_processor.pipeline = true;
+	auto & node = *system.add_node (config);
+	nano::state_block_builder builder;
+	auto send1 = builder.make_block ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .build ();
+	auto send2 = builder.make_block ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 2 * nano::Gxrb_ratio)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (send1->hash ()))
+				 .build ();
+	auto send3 = builder.make_block ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send2->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 3 * nano::Gxrb_ratio)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (send2->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, node.block_processor.add_blocking (send1, nano::block_source::local));
+	ASSERT_EQ (nano::block_status::old, node.block_processor.add_blocking (send1, nano::block_source::local));
+	ASSERT_EQ (nano::block_status::gap_previous, node.block_processor.add_blocking (send3, nano::block_source::local));
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::blockprocessor, nano::stat::detail::prechecked));
+	// Processing send2 triggers send3 from unchecked
+	ASSERT_EQ (nano::block_status::progress, node.block_processor.add_blocking (send2, nano::block_source::local));
+	ASSERT_TIMELY (5s, node.block_or_pruned_exists (send3->hash ()));
+	ASSERT_TIMELY_EQ (5s, node.stats.count (nano::stat::type::blockprocessor_result, nano::stat::detail::progress), 3);
+}
@@ -19,13 +19,15 @@ using namespace std::chrono_literals;
 TEST (confirming_set, construction)
 {
 	auto ctx = nano::test::context::ledger_empty ();
-	nano::confirming_set confirming_set (ctx.ledger (), ctx.stats ());
+	nano::confirming_set_config config{};
+	nano::confirming_set confirming_set (config, ctx.ledger (), ctx.stats ());
 }
 
 TEST (confirming_set, add_exists)
 {
 	auto ctx = nano::test::context::ledger_send_receive ();
-	nano::confirming_set confirming_set (ctx.ledger (), ctx.stats ());
+	nano::confirming_set_config config{};
+	nano::confirming_set confirming_set (config, ctx.ledger (), ctx.stats ());
 	auto send = ctx.blocks ()[0];
 	confirming_set.add (send->hash ());
 	ASSERT_TRUE (confirming_set.exists (send->hash ()));
@@ -34,7 +36,8 @@ TEST (confirming_set, add_exists)
 TEST (confirming_set, process_one)
 {
 	auto ctx = nano::test::context::ledger_send_receive ();
-	nano::confirming_set confirming_set (ctx.ledger (), ctx.stats ());
+	nano::confirming_set_config config{};
+	nano::confirming_set confirming_set (config, ctx.ledger (), ctx.stats ());
 	std::atomic<int> count = 0;
 	std::mutex mutex;
 	std::condition_variable condition;
@@ -50,7 +53,8 @@ TEST (confirming_set, process_one)
 TEST (confirming_set, process_multiple)
 {
 	auto ctx = nano::test::context::ledger_send_receive ();
-	nano::confirming_set confirming_set (ctx.ledger (), ctx.stats ());
+	nano::confirming_set_config config{};
+	nano::confirming_set confirming_set (config, ctx.ledger (), ctx.stats ());
 	std::atomic<int> count = 0;
 	std::mutex mutex;
 	std::condition_variable condition;
@@ -64,6 +68,25 @@ TEST (confirming_set, process_multiple)
 	ASSERT_EQ (3, ctx.ledger ().cemented_count ());
 }
 
+// Implicitly confirmed dependencies are committed and notified in separate chunks
+TEST (confirming_set, process_chunked)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	nano::confirming_set_config config{};
+	config.cementing_chunk_size = 1;
+	nano::confirming_set confirming_set (config, ctx.ledger (), ctx.stats ());
+	std::atomic<int> count = 0;
+	std::mutex mutex;
+	std::condition_variable condition;
+	confirming_set.cemented_observers.add ([&] (auto const &) { ++count; condition.notify_all (); });
+	confirming_set.add (ctx.blocks ()[1]->hash ());
+	nano::test::start_stop_guard guard{ confirming_set };
+	std::unique_lock lock{ mutex };
+	ASSERT_TRUE (condition.wait_for (lock, 5s, [&] () { return count == 2; }));
+	ASSERT_EQ (2, ctx.stats ().count (nano::stat::type::confirming_set, nano::stat::detail::cemented_chunk));
+	ASSERT_EQ (3, ctx.ledger ().cemented_count ());
+}
+
 TEST (confirmation_callback, observer_callbacks)
 {
 	nano::test::system system;
@@ -307,3 +307,112 @@ TEST (election, continuous_voting)
 	// Ensure votes are broadcasted in continuous manner
 	ASSERT_TIMELY (5s, node1.stats.count (nano::stat::type::election, nano::stat::detail::broadcast_vote) >= 5);
 }
+
+// A representative changing its vote moves its weight between blocks without affecting the rest of the tally
+TEST (election, tally_vote_change)
+{
+	nano::test::system system{};
+
+	nano::node_config node_config = system.default_config ();
+	// Keep the election below quorum so it does not flip or confirm
+	node_config.online_weight_minimum = nano::dev::constants.genesis_amount * 2;
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+
+	auto & node1 = *system.add_node (node_config);
+	auto const latest_hash = nano::dev::genesis->hash ();
+	nano::state_block_builder builder{};
+
+	nano::keypair key1{};
+	auto send1 = builder.make_block ()
+				 .previous (latest_hash)
+				 .account (nano::dev::genesis_key.pub)
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (key1.pub)
+				 .work (*system.work.generate (latest_hash))
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .build ();
+
+	nano::keypair key2{};
+	auto send2 = builder.make_block ()
+				 .previous (latest_hash)
+				 .account (nano::dev::genesis_key.pub)
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (key2.pub)
+				 .work (*system.work.generate (latest_hash))
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .build ();
+
+	node1.process_active (send1);
+	std::shared_ptr<nano::election> election{};
+	ASSERT_TIMELY (5s, (election = node1.active.election (send1->qualified_root ())) != nullptr)
+	node1.process_active (send2);
+	ASSERT_TIMELY_EQ (5s, election->blocks ().size (), 2);
+
+	auto const weight = node1.ledger.weight (nano::dev::genesis_key.pub);
+	ASSERT_EQ (nano::vote_code::vote, election->vote (nano::dev::genesis_key.pub, 1, send1->hash (), nano::vote_source::cache));
+	{
+		auto tally = election->tally ();
+		ASSERT_EQ (1, tally.size ());
+		ASSERT_EQ (weight, tally.begin ()->first);
+		ASSERT_EQ (*send1, *tally.begin ()->second);
+	}
+
+	ASSERT_EQ (nano::vote_code::vote, election->vote (nano::dev::genesis_key.pub, 2, send2->hash (), nano::vote_source::cache));
+	{
+		// The initial winner keeps its entry, backed only by the zero weight placeholder vote
+		auto tally = election->tally ();
+		ASSERT_EQ (2, tally.size ());
+		ASSERT_EQ (weight, tally.begin ()->first);
+		ASSERT_EQ (*send2, *tally.begin ()->second);
+		ASSERT_EQ (0, std::next (tally.begin ())->first);
+	}
+	ASSERT_FALSE (election->confirmed ());
+}
+
+// Weight changes of representatives that already voted are reflected in the tally without further votes
+TEST (election, tally_weight_change)
+{
+	nano::test::system system{};
+
+	nano::node_config node_config = system.default_config ();
+	// Keep the election below quorum so it does not confirm
+	node_config.online_weight_minimum = nano::dev::constants.genesis_amount * 2;
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+
+	auto & node1 = *system.add_node (node_config);
+	nano::state_block_builder builder{};
+
+	nano::keypair key1{};
+	auto send1 = builder.make_block ()
+				 .previous (nano::dev::genesis->hash ())
+				 .account (nano::dev::genesis_key.pub)
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (key1.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .build ();
+
+	node1.process_active (send1);
+	std::shared_ptr<nano::election> election{};
+	ASSERT_TIMELY (5s, (election = node1.active.election (send1->qualified_root ())) != nullptr)
+	ASSERT_EQ (nano::vote_code::vote, election->vote (nano::dev::genesis_key.pub, 1, send1->hash (), nano::vote_source::cache));
+	ASSERT_EQ (node1.ledger.weight (nano::dev::genesis_key.pub), election->tally ().begin ()->first);
+
+	// Moves weight away from the representative that voted
+	auto send2 = builder.make_block ()
+				 .previous (send1->hash ())
+				 .account (nano::dev::genesis_key.pub)
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				 .link (key1.pub)
+				 .work (*system.work.generate (send1->hash ()))
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, node1.process (send2));
+	ASSERT_EQ (nano::dev::constants.genesis_amount - nano::Gxrb_ratio, node1.ledger.weight (nano::dev::genesis_key.pub));
+	ASSERT_TIMELY_EQ (5s, election->tally ().begin ()->first, nano::dev::constants.genesis_amount - nano::Gxrb_ratio);
+	ASSERT_FALSE (election->confirmed ());
+}
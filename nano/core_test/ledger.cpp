@@ -13,6 +13,7 @@
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/secure/ledger_set_confirmed.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
+#include <nano/store/version.hpp>
 #include <nano/test_common/ledger.hpp>
 #include <nano/test_common/make_store.hpp>
 #include <nano/test_common/system.hpp>
@@ -684,6 +685,62 @@ TEST (ledger, representation_changes)
 	ASSERT_EQ (2, rep_weights.representation_get (key1.pub));
 }
 
+// Lookups keep working while the lock free table grows and reuses slots of removed representatives
+TEST (ledger, representation_table_grow)
+{
+	auto store{ nano::test::make_store () };
+	nano::rep_weights rep_weights{ store->rep_weight };
+	auto const count = nano::rep_weights::initial_table_capacity * 3;
+	for (auto i = 1u; i <= count; ++i)
+	{
+		rep_weights.representation_put (i, i);
+	}
+	ASSERT_EQ (count, rep_weights.size ());
+	for (auto i = 1u; i <= count; ++i)
+	{
+		ASSERT_EQ (i, rep_weights.representation_get (i));
+	}
+	for (auto i = 1u; i <= count; i += 2)
+	{
+		rep_weights.representation_put (i, 0);
+	}
+	ASSERT_EQ (count / 2, rep_weights.size ());
+	for (auto i = 1u; i <= count; ++i)
+	{
+		ASSERT_EQ (i % 2 == 0 ? i : 0, rep_weights.representation_get (i));
+	}
+	for (auto i = count + 1; i <= count * 2; ++i)
+	{
+		rep_weights.representation_put (i, i);
+	}
+	for (auto i = count + 1; i <= count * 2; ++i)
+	{
+		ASSERT_EQ (i, rep_weights.representation_get (i));
+	}
+	ASSERT_EQ (0, rep_weights.representation_get (count * 2 + 1));
+}
+
+// Representatives coming and going leave removed entries behind, rebuilding the table for them must not grow it
+TEST (ledger, representation_table_churn)
+{
+	auto store{ nano::test::make_store () };
+	nano::rep_weights rep_weights{ store->rep_weight };
+	auto const live = 100u;
+	for (auto i = 1u; i <= nano::rep_weights::initial_table_capacity * 10; ++i)
+	{
+		rep_weights.representation_put (i, i);
+		if (i > live)
+		{
+			rep_weights.representation_put (i - live, 0);
+		}
+	}
+	ASSERT_EQ (live, rep_weights.size ());
+	ASSERT_EQ (nano::rep_weights::initial_table_capacity, rep_weights.table_capacity ());
+	auto const last = nano::rep_weights::initial_table_capacity * 10;
+	ASSERT_EQ (last, rep_weights.representation_get (last));
+	ASSERT_EQ (0, rep_weights.representation_get (last - live));
+}
+
 TEST (ledger, delete_rep_weight_of_zero)
 {
 	auto store{ nano::test::make_store () };
@@ -4768,6 +4825,64 @@ TEST (ledger, block_confirmed)
 	ASSERT_TRUE (ledger.confirmed.block_exists_or_pruned (transaction, send1->hash ()));
 }
 
+// Resolving returns the blocks confirm would cement, in the same order, without cementing anything
+TEST (ledger, confirm_resolve)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	auto & ledger = ctx.ledger ();
+	auto send = ctx.blocks ()[0];
+	auto receive = ctx.blocks ()[1];
+	auto transaction = ledger.tx_begin_write ();
+	auto resolved = ledger.confirm_resolve (transaction, receive->hash (), 16);
+	ASSERT_EQ (2, resolved.size ());
+	ASSERT_EQ (*send, *resolved[0]);
+	ASSERT_EQ (*receive, *resolved[1]);
+	ASSERT_FALSE (ledger.confirmed.block_exists_or_pruned (transaction, send->hash ()));
+	ASSERT_EQ (1, ledger.confirm_resolve (transaction, receive->hash (), 1).size ());
+	auto cemented = ledger.confirm (transaction, receive->hash ());
+	ASSERT_EQ (2, cemented.size ());
+	ASSERT_EQ (*send, *cemented[0]);
+	ASSERT_EQ (*receive, *cemented[1]);
+	ASSERT_TRUE (ledger.confirm_resolve (transaction, receive->hash (), 16).empty ());
+}
+
+// Resolved blocks are cemented without walking dependencies again, skipping blocks cemented in the meantime
+TEST (ledger, confirm_resolved)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	auto & ledger = ctx.ledger ();
+	auto send = ctx.blocks ()[0];
+	auto receive = ctx.blocks ()[1];
+	auto transaction = ledger.tx_begin_write ();
+	auto resolved = ledger.confirm_resolve (transaction, receive->hash (), 16);
+	ASSERT_EQ (2, resolved.size ());
+	ASSERT_EQ (1, ledger.confirm (transaction, send->hash ()).size ());
+	std::deque<std::shared_ptr<nano::block>> cemented;
+	ASSERT_FALSE (ledger.confirm_resolved (transaction, resolved, 16, [&cemented] (std::deque<std::shared_ptr<nano::block>> & blocks) {
+		std::move (blocks.begin (), blocks.end (), std::back_inserter (cemented));
+	}));
+	ASSERT_EQ (1, cemented.size ());
+	ASSERT_EQ (*receive, *cemented[0]);
+	ASSERT_TRUE (ledger.confirmed.block_exists_or_pruned (transaction, receive->hash ()));
+}
+
+// Resolved blocks which were rolled back since resolving are not cemented
+TEST (ledger, confirm_resolved_stale)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	auto & ledger = ctx.ledger ();
+	auto send = ctx.blocks ()[0];
+	auto receive = ctx.blocks ()[1];
+	auto transaction = ledger.tx_begin_write ();
+	auto resolved = ledger.confirm_resolve (transaction, receive->hash (), 16);
+	ASSERT_EQ (2, resolved.size ());
+	ASSERT_FALSE (ledger.rollback (transaction, receive->hash ()));
+	ASSERT_TRUE (ledger.confirm_resolved (transaction, resolved, 16, [] (std::deque<std::shared_ptr<nano::block>> &) {
+		FAIL ();
+	}));
+	ASSERT_FALSE (ledger.confirmed.block_exists_or_pruned (transaction, send->hash ()));
+}
+
 TEST (ledger, cache)
 {
 	auto ctx = nano::test::context::ledger_empty ();
@@ -4866,6 +4981,66 @@ TEST (ledger, cache)
 	}
 }
 
+// Persisted counters are trusted on startup and corrected by the background recount when they drift
+TEST (ledger, persisted_counts)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	auto & ledger = ctx.ledger ();
+	auto & store = ctx.store ();
+	auto & stats = ctx.stats ();
+
+	auto const block_count = ledger.block_count ();
+	auto const account_count = ledger.account_count ();
+	auto const cemented_count = ledger.cemented_count ();
+	ASSERT_FALSE (ledger.verify_counts ());
+	{
+		auto transaction = ledger.tx_begin_read ();
+		ASSERT_EQ (block_count, store.version.counter_get (transaction, nano::store::counter::block_count));
+		ASSERT_EQ (account_count, store.version.counter_get (transaction, nano::store::counter::account_count));
+		ASSERT_EQ (cemented_count, store.version.counter_get (transaction, nano::store::counter::cemented_count));
+	}
+
+	{
+		auto transaction = ledger.tx_begin_write ();
+		store.version.counter_put (transaction, nano::store::counter::block_count, block_count + 10);
+		store.version.counter_del (transaction, nano::store::counter::cemented_count);
+	}
+	nano::ledger reloaded{ store, stats, nano::dev::constants };
+	ASSERT_EQ (block_count + 10, reloaded.block_count ());
+	ASSERT_EQ (cemented_count, reloaded.cemented_count ());
+
+	ASSERT_TRUE (reloaded.verify_counts ());
+	ASSERT_EQ (block_count, reloaded.block_count ());
+	ASSERT_EQ (account_count, reloaded.account_count ());
+	ASSERT_EQ (cemented_count, reloaded.cemented_count ());
+	ASSERT_EQ (2, stats.count (nano::stat::type::ledger, nano::stat::detail::counter_corrected));
+	ASSERT_FALSE (reloaded.verify_counts ());
+	ASSERT_EQ (block_count, nano::ledger (store, stats, nano::dev::constants).block_count ());
+}
+
+TEST (ledger, prefetch)
+{
+	auto ctx = nano::test::context::ledger_empty ();
+	auto & ledger = ctx.ledger ();
+	auto & pool = ctx.pool ();
+	nano::keypair key;
+	auto send = nano::state_block_builder ()
+				.account (nano::dev::genesis_key.pub)
+				.previous (nano::dev::genesis->hash ())
+				.representative (nano::dev::genesis_key.pub)
+				.balance (nano::dev::constants.genesis_amount - 1)
+				.link (key.pub)
+				.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				.work (*pool.generate (nano::dev::genesis->hash ()))
+				.build ();
+	ledger.block_cache.clear ();
+	ledger.prefetch (ledger.tx_begin_read (), { send });
+	// The previous block is decoded ahead of processing
+	ASSERT_EQ (1, ledger.block_cache.size ());
+	auto transaction = ledger.tx_begin_write ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send));
+}
+
 TEST (ledger, pruning_action)
 {
 	nano::logger logger;
@@ -1,4 +1,5 @@
 #include <nano/lib/blocks.hpp>
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/lib/memory.hpp>
 #include <nano/node/active_elections.hpp>
 #include <nano/secure/common.hpp>
@@ -88,3 +89,34 @@ TEST (memory_pool, validate_cleanup)
 	ASSERT_EQ (nano::determine_shared_ptr_pool_size<nano::state_block> (), get_allocated_size<nano::state_block> () - sizeof (size_t));
 	ASSERT_EQ (nano::determine_shared_ptr_pool_size<nano::vote> (), get_allocated_size<nano::vote> () - sizeof (size_t));
 }
+
+TEST (buffer_pool, reuse)
+{
+	if (!nano::get_use_memory_pools ())
+	{
+		return;
+	}
+
+	auto & pool = nano::buffer_pool::instance ();
+	uint8_t const * storage = nullptr;
+	{
+		auto buffer = pool.acquire (100);
+		ASSERT_TRUE (buffer->empty ());
+		ASSERT_GE (buffer->capacity (), nano::buffer_pool::size_classes.front ());
+		buffer->resize (100);
+		storage = buffer->data ();
+	}
+	// The same thread gets the released buffer back, emptied
+	auto buffer = pool.acquire (200);
+	ASSERT_TRUE (buffer->empty ());
+	buffer->resize (1);
+	ASSERT_EQ (storage, buffer->data ());
+
+	// Larger requests are served from a larger class
+	auto large = pool.acquire (nano::buffer_pool::size_classes.front () + 1);
+	ASSERT_GE (large->capacity (), nano::buffer_pool::size_classes[1]);
+
+	// Requests above the largest class are still served
+	auto huge = pool.acquire (nano::buffer_pool::size_classes.back () + 1);
+	ASSERT_GE (huge->capacity (), nano::buffer_pool::size_classes.back () + 1);
+}
@@ -582,6 +582,58 @@ TEST (message, asc_pull_ack_serialization_blocks)
 	ASSERT_TRUE (nano::at_end (stream));
 }
 
+TEST (message, asc_pull_ack_serialization_serialized_blocks)
+{
+	nano::asc_pull_ack original{ nano::dev::network_params.network };
+	original.id = 11;
+	original.type = nano::asc_pull_type::blocks;
+
+	// Mix of decoded blocks and blocks already in network serialization
+	nano::asc_pull_ack::blocks_payload original_payload{};
+	std::vector<std::shared_ptr<nano::block>> expected;
+	for (int n = 0; n < 4; ++n)
+	{
+		auto block = random_block ();
+		original_payload.blocks.push_back (block);
+		expected.push_back (block);
+	}
+	for (int n = 0; n < 4; ++n)
+	{
+		auto block = random_block ();
+		nano::vectorstream stream{ original_payload.serialized };
+		nano::serialize_block (stream, *block);
+		++original_payload.serialized_count;
+		expected.push_back (block);
+	}
+	ASSERT_EQ (8, original_payload.size ());
+
+	original.payload = original_payload;
+	original.update_header ();
+
+	// Serialize
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream{ bytes };
+		original.serialize (stream);
+	}
+	nano::bufferstream stream{ bytes.data (), bytes.size () };
+
+	bool error = false;
+	nano::message_header header (error, stream);
+	ASSERT_FALSE (error);
+	nano::asc_pull_ack message (error, stream, header);
+	ASSERT_FALSE (error);
+
+	nano::asc_pull_ack::blocks_payload message_payload;
+	ASSERT_NO_THROW (message_payload = std::get<nano::asc_pull_ack::blocks_payload> (message.payload));
+	ASSERT_EQ (0, message_payload.serialized_count);
+	ASSERT_TRUE (std::equal (expected.begin (), expected.end (), message_payload.blocks.begin (), message_payload.blocks.end (), [] (auto a, auto b) {
+		return *a == *b;
+	}));
+
+	ASSERT_TRUE (nano::at_end (stream));
+}
+
 TEST (message, asc_pull_ack_serialization_account_info)
 {
 	nano::asc_pull_ack original{ nano::dev::network_params.network };
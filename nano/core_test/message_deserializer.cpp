@@ -24,7 +24,7 @@ auto message_deserializer_success_checker (message_type & message_original) -> v
 	std::size_t offset{ 0 };
 
 	// Message Deserializer with the query function tweaked to read from the `input_source`.
-	auto const message_deserializer = std::make_shared<nano::transport::message_deserializer> (nano::dev::network_params.network, filter, block_uniquer, vote_uniquer,
+	auto const message_deserializer = std::make_shared<nano::transport::message_deserializer> (nano::dev::network_params.network, filter, filter, block_uniquer, vote_uniquer,
 	[&input_source, &offset] (std::shared_ptr<std::vector<uint8_t>> const & data_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a) {
 		debug_assert (input_source.size () >= size_a);
 		data_a->resize (size_a);
@@ -203,3 +203,103 @@ TEST (message_deserializer, exact_asc_pull_ack)
 
 	message_deserializer_success_checker<decltype (message)> (message);
 }
+
+// Several messages arriving in one stream, split at arbitrary points, are all parsed from the read-ahead buffer
+TEST (message_deserializer, buffered_reads)
+{
+	nano::network_filter filter (1);
+	nano::block_uniquer block_uniquer;
+	nano::vote_uniquer vote_uniquer;
+
+	std::vector<std::unique_ptr<nano::message>> messages;
+	messages.push_back (std::make_unique<nano::keepalive> (nano::dev::network_params.network));
+	messages.push_back (std::make_unique<nano::telemetry_req> (nano::dev::network_params.network));
+	messages.push_back (std::make_unique<nano::keepalive> (nano::dev::network_params.network));
+
+	std::vector<uint8_t> input_source;
+	{
+		nano::vectorstream stream (input_source);
+		for (auto const & message : messages)
+		{
+			message->serialize (stream);
+		}
+	}
+
+	std::size_t offset{ 0 };
+	std::size_t reads{ 0 };
+	auto const message_deserializer = std::make_shared<nano::transport::message_deserializer> (nano::dev::network_params.network, filter, filter, block_uniquer, vote_uniquer,
+	[] (std::shared_ptr<std::vector<uint8_t>> const &, std::size_t, std::function<void (boost::system::error_code const &, std::size_t)> callback_a) {
+		FAIL () << "exact reads are not used when buffering";
+	},
+	[&input_source, &offset, &reads] (std::shared_ptr<std::vector<uint8_t>> const & data_a, std::size_t offset_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a) {
+		// Hand out at most 100 bytes per read so messages straddle reads
+		auto const count = std::min ({ size_a, input_source.size () - offset, std::size_t{ 100 } });
+		debug_assert (offset_a + count <= data_a->size ());
+		std::copy (input_source.begin () + offset, input_source.begin () + offset + count, data_a->data () + offset_a);
+		offset += count;
+		++reads;
+		callback_a (boost::system::errc::make_error_code (boost::system::errc::success), count);
+	});
+	message_deserializer->enable_buffering ();
+
+	for (auto const & original : messages)
+	{
+		std::unique_ptr<nano::message> result;
+		message_deserializer->read ([&result] (boost::system::error_code ec_a, std::unique_ptr<nano::message> message_a) {
+			ASSERT_FALSE (ec_a);
+			result = std::move (message_a);
+		});
+		ASSERT_EQ (message_deserializer->status, nano::transport::parse_status::success);
+		ASSERT_NE (result, nullptr);
+		ASSERT_EQ (result->type (), original->type ());
+		ASSERT_EQ (*result->to_bytes (), *original->to_bytes ());
+	}
+	ASSERT_EQ (offset, input_source.size ());
+	// Fewer reads than a header plus payload read per message
+	ASSERT_LT (reads, 2 * messages.size ());
+}
+
+// Repeated rebroadcasts of a vote are dropped, direct copies from representatives always get through
+TEST (message_deserializer, duplicate_rebroadcasted_vote)
+{
+	nano::network_filter publish_filter (1);
+	nano::network_filter vote_filter (1024);
+	nano::block_uniquer block_uniquer;
+	nano::vote_uniquer vote_uniquer;
+
+	auto vote = std::make_shared<nano::vote> (nano::dev::genesis_key.pub, nano::dev::genesis_key.prv, 0, 0, std::vector<nano::block_hash>{ nano::dev::genesis->hash () });
+	nano::confirm_ack live{ nano::dev::network_params.network, vote };
+	nano::confirm_ack rebroadcasted{ nano::dev::network_params.network, vote, true };
+
+	std::vector<uint8_t> input_source;
+	std::size_t offset{ 0 };
+	auto const message_deserializer = std::make_shared<nano::transport::message_deserializer> (nano::dev::network_params.network, publish_filter, vote_filter, block_uniquer, vote_uniquer,
+	[&input_source, &offset] (std::shared_ptr<std::vector<uint8_t>> const & data_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a) {
+		debug_assert (input_source.size () >= offset + size_a);
+		data_a->resize (size_a);
+		std::copy (input_source.begin () + offset, input_source.begin () + offset + size_a, data_a->data ());
+		offset += size_a;
+		callback_a (boost::system::errc::make_error_code (boost::system::errc::success), size_a);
+	});
+
+	auto receive = [&] (nano::confirm_ack const & message) {
+		input_source = *message.to_bytes ();
+		offset = 0;
+		bool received = false;
+		message_deserializer->read ([&received] (boost::system::error_code ec_a, std::unique_ptr<nano::message> message_a) {
+			received = message_a != nullptr;
+		});
+		return received;
+	};
+
+	ASSERT_TRUE (receive (rebroadcasted));
+	ASSERT_FALSE (receive (rebroadcasted));
+	ASSERT_EQ (message_deserializer->status, nano::transport::parse_status::duplicate_confirm_ack_message);
+	ASSERT_TRUE (receive (live));
+	ASSERT_TRUE (receive (live));
+
+	// Cleared votes are accepted again
+	auto const bytes = rebroadcasted.to_bytes ();
+	vote_filter.clear (bytes->data () + nano::message_header::size, bytes->size () - nano::message_header::size);
+	ASSERT_TRUE (receive (rebroadcasted));
+}
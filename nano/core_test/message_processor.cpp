@@ -0,0 +1,62 @@
+#include <nano/node/message_processor.hpp>
+#include <nano/node/messages.hpp>
+#include <nano/node/node.hpp>
+#include <nano/node/transport/fake.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST (message_processor, staging)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	auto channel = std::make_shared<nano::transport::fake::channel> (node);
+	auto const initial = node.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in);
+
+	for (auto i = 0; i < 32; ++i)
+	{
+		ASSERT_TRUE (node.message_processor.put (std::make_unique<nano::keepalive> (nano::dev::network_params.network), channel));
+	}
+	ASSERT_TIMELY_EQ (5s, initial + 32, node.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in));
+	ASSERT_EQ (32, node.stats.count (nano::stat::type::message_processor, nano::stat::detail::staging));
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::message_processor, nano::stat::detail::staging_overfill));
+}
+
+TEST (message_processor, direct)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.message_processor.staging = false;
+	auto & node = *system.add_node (config);
+	auto channel = std::make_shared<nano::transport::fake::channel> (node);
+	auto const initial = node.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in);
+
+	for (auto i = 0; i < 32; ++i)
+	{
+		ASSERT_TRUE (node.message_processor.put (std::make_unique<nano::keepalive> (nano::dev::network_params.network), channel));
+	}
+	ASSERT_TIMELY_EQ (5s, initial + 32, node.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in));
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::message_processor, nano::stat::detail::staging));
+}
+
+// Messages that don't fit into staging fall back to the processing queue instead of being dropped
+TEST (message_processor, staging_full)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.message_processor.max_staging = 0;
+	auto & node = *system.add_node (config);
+	auto channel = std::make_shared<nano::transport::fake::channel> (node);
+	auto const initial = node.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in);
+
+	for (auto i = 0; i < 32; ++i)
+	{
+		ASSERT_TRUE (node.message_processor.put (std::make_unique<nano::keepalive> (nano::dev::network_params.network), channel));
+	}
+	ASSERT_TIMELY_EQ (5s, initial + 32, node.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in));
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::message_processor, nano::stat::detail::staging));
+	ASSERT_EQ (32, node.stats.count (nano::stat::type::message_processor, nano::stat::detail::staging_overfill));
+}
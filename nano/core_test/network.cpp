@@ -5,6 +5,7 @@
 #include <nano/node/scheduler/component.hpp>
 #include <nano/node/scheduler/priority.hpp>
 #include <nano/node/transport/inproc.hpp>
+#include <nano/node/transport/io_shards.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/transport/tcp_socket.hpp>
 #include <nano/secure/ledger.hpp>
@@ -109,6 +110,48 @@ TEST (network, send_node_id_handshake_tcp)
 	ASSERT_EQ (node0->get_node_id (), list2[0]->get_node_id ());
 }
 
+TEST (network, list_sampling)
+{
+	nano::test::system system (3);
+	auto & node = *system.nodes[0];
+	ASSERT_TIMELY_EQ (5s, 2, node.network.size ());
+
+	auto all = node.network.list ();
+	ASSERT_EQ (2, all.size ());
+	ASSERT_NE (all[0], all[1]);
+	ASSERT_EQ (1, node.network.list (1).size ());
+
+	// Principal representatives are left out of the non-PR list once the rep is known
+	ASSERT_EQ (2, node.network.list_non_pr (10).size ());
+	node.rep_crawler.force_add_rep (nano::dev::genesis_key.pub, all[0]);
+	auto non_pr = node.network.list_non_pr (10);
+	ASSERT_EQ (1, non_pr.size ());
+	ASSERT_EQ (all[1], non_pr[0]);
+}
+
+TEST (network, io_shards)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.io_shards = 2;
+	auto & node1 = *system.add_node (config);
+	auto & node2 = *system.add_node ();
+	ASSERT_EQ (2, node1.io_shards.size ());
+	ASSERT_FALSE (node2.io_shards.enabled ());
+	ASSERT_EQ (nullptr, node2.io_shards.select ());
+
+	// Handshake and keepalives go through sockets served by the shard threads
+	ASSERT_TIMELY_EQ (5s, 1, node1.network.size ());
+	ASSERT_TIMELY_EQ (5s, 1, node2.network.size ());
+	ASSERT_TIMELY_EQ (5s, 1, node1.io_shards.load ());
+	ASSERT_TIMELY_EQ (5s, 1, node1.tcp_listener.sockets ().size ());
+
+	// The next connection goes to the shard that is still empty
+	auto shard = node1.io_shards.select ();
+	ASSERT_NE (nullptr, shard);
+	ASSERT_EQ (0, shard->load ());
+}
+
 TEST (network, last_contacted)
 {
 	nano::test::system system (1);
@@ -258,6 +301,22 @@ TEST (network, send_valid_confirm_ack)
 	ASSERT_EQ (50, node2.balance (nano::dev::genesis_key.pub));
 }
 
+// A flooded vote is serialized once and delivered to every peer, outgoing messages are still counted per channel
+TEST (network, flood_vote_shared_buffer)
+{
+	nano::test::system system (3);
+	auto & node1 (*system.nodes[0]);
+	auto & node2 (*system.nodes[1]);
+	auto & node3 (*system.nodes[2]);
+	ASSERT_TIMELY_EQ (5s, node1.network.size (), 2);
+
+	auto vote = nano::test::make_vote (nano::dev::genesis_key, { nano::dev::genesis->hash () });
+	node1.network.flood_vote (vote, 2.0f);
+	ASSERT_TIMELY (5s, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::in) >= 1);
+	ASSERT_TIMELY (5s, node3.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::in) >= 1);
+	ASSERT_GE (node1.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out), 2);
+}
+
 TEST (network, send_valid_publish)
 {
 	auto type = nano::transport::transport_type::tcp;
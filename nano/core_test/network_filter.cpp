@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+#include <thread>
+
 TEST (network_filter, unit)
 {
 	nano::network_filter filter (1);
@@ -127,3 +130,51 @@ TEST (network_filter, optional_digest)
 	filter.clear (digest);
 	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
 }
+
+// Reference vectors from the SipHash paper's 128-bit output variant, key 00..0f and messages 00, 00 01, ...
+TEST (network_filter, siphash_reference)
+{
+	std::array<uint8_t, 16> key;
+	std::iota (key.begin (), key.end (), 0);
+	std::vector<uint8_t> message (16);
+	std::iota (message.begin (), message.end (), 0);
+
+	auto expected = [] (std::string const & hex) {
+		nano::uint128_union result;
+		EXPECT_FALSE (result.decode_hex (hex));
+		return result.number ();
+	};
+	ASSERT_EQ (expected ("A3817F04BA25A8E66DF67214C7550293"), nano::network_filter::siphash (key, message.data (), 0));
+	ASSERT_EQ (expected ("DA87C1D86B99AF44347659119B22FC45"), nano::network_filter::siphash (key, message.data (), 1));
+	ASSERT_EQ (expected ("5493E99933B0A8117E08EC0F97CFC3D9"), nano::network_filter::siphash (key, message.data (), 15));
+}
+
+TEST (network_filter, concurrent_apply)
+{
+	nano::network_filter filter (1024);
+	std::atomic<int> unique{ 0 };
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back ([&filter, &unique] () {
+			for (uint8_t value = 0; value < 100; ++value)
+			{
+				if (!filter.apply (&value, sizeof (value)))
+				{
+					++unique;
+				}
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	// Each value is reported as new at least once, and only more than once if threads raced on it or values share a slot
+	ASSERT_GE (unique, 100);
+	for (uint8_t value = 0; value < 100; ++value)
+	{
+		filter.clear (&value, sizeof (value));
+		ASSERT_FALSE (filter.apply (&value, sizeof (value)));
+	}
+}
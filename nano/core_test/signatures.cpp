@@ -0,0 +1,80 @@
+#include <nano/lib/numbers.hpp>
+#include <nano/node/signatures.hpp>
+#include <nano/secure/common.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+nano::signature_check_set make_check_set (std::size_t size)
+{
+	nano::signature_check_set check;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		nano::keypair key;
+		nano::uint256_union message{ i };
+		check.add (key.pub, message, nano::sign_message (key.prv, key.pub, message));
+	}
+	return check;
+}
+}
+
+TEST (signature_checker, empty)
+{
+	nano::signature_checker checker{ 4 };
+	nano::signature_check_set check;
+	checker.verify (check);
+	ASSERT_TRUE (check.empty ());
+}
+
+TEST (signature_checker, valid)
+{
+	nano::signature_checker checker{ 4 };
+	auto check = make_check_set (1000);
+	checker.verify (check);
+	for (std::size_t i = 0; i < check.size (); ++i)
+	{
+		ASSERT_TRUE (check.valid (i));
+	}
+}
+
+TEST (signature_checker, invalid)
+{
+	nano::signature_checker checker{ 4 };
+	auto check = make_check_set (1000);
+	// Signed with the wrong key, must fail even though every other entry in its batch is valid
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::uint256_union message{ 1 };
+	auto index = check.add (key1.pub, message, nano::sign_message (key2.prv, key2.pub, message));
+	checker.verify (check);
+	for (std::size_t i = 0; i < check.size (); ++i)
+	{
+		ASSERT_EQ (check.valid (i), i != index);
+	}
+}
+
+// Without worker threads the calling thread does all of the work
+TEST (signature_checker, no_threads)
+{
+	nano::signature_checker checker{ 0 };
+	auto check = make_check_set (300);
+	checker.verify (check);
+	for (std::size_t i = 0; i < check.size (); ++i)
+	{
+		ASSERT_TRUE (check.valid (i));
+	}
+}
+
+// Verification after stopping leaves every entry unverified instead of blocking
+TEST (signature_checker, stopped)
+{
+	nano::signature_checker checker{ 4 };
+	checker.stop ();
+	auto check = make_check_set (300);
+	checker.verify (check);
+	for (std::size_t i = 0; i < check.size (); ++i)
+	{
+		ASSERT_FALSE (check.valid (i));
+	}
+}
@@ -476,6 +476,104 @@ TEST (socket, concurrent_writes)
 	}
 }
 
+// Messages queued while a write is in progress are sent together in one gathered write, in order, with every callback invoked
+TEST (socket, write_coalescing)
+{
+	nano::test::system system (1);
+	std::shared_ptr<nano::node> node = system.nodes[0];
+
+	boost::asio::ip::tcp::endpoint endpoint (boost::asio::ip::address_v6::loopback (), system.get_available_port ());
+	boost::asio::ip::tcp::acceptor acceptor (*system.io_ctx);
+	acceptor.open (endpoint.protocol ());
+	acceptor.bind (endpoint);
+	acceptor.listen (boost::asio::socket_base::max_listen_connections);
+
+	boost::asio::ip::tcp::socket newsock (*system.io_ctx);
+	acceptor.async_accept (newsock, [] (boost::system::error_code const & ec_a) {
+		EXPECT_FALSE (ec_a);
+	});
+
+	constexpr std::size_t message_count = 256;
+	auto socket = std::make_shared<nano::transport::tcp_socket> (*node, nano::transport::socket_endpoint::client, message_count);
+	std::atomic<std::size_t> completed{ 0 };
+	socket->async_connect (acceptor.local_endpoint (), [&socket, &completed] (boost::system::error_code const & ec_a) {
+		EXPECT_FALSE (ec_a);
+		for (std::size_t i = 0; i < message_count; ++i)
+		{
+			socket->async_write (nano::shared_const_buffer{ static_cast<uint8_t> (i) }, [&completed] (boost::system::error_code const & ec_a, size_t size_a) {
+				EXPECT_FALSE (ec_a);
+				EXPECT_EQ (1, size_a);
+				++completed;
+			});
+		}
+	});
+
+	ASSERT_TIMELY_EQ (5s, completed, message_count);
+	ASSERT_LT (0, node->stats.count (nano::stat::type::tcp, nano::stat::detail::tcp_write_coalesced, nano::stat::dir::out));
+
+	std::vector<uint8_t> received (message_count);
+	boost::asio::read (newsock, boost::asio::buffer (received));
+	for (std::size_t i = 0; i < message_count; ++i)
+	{
+		ASSERT_EQ (static_cast<uint8_t> (i), received[i]);
+	}
+}
+
+TEST (socket_queue, deficit_round_robin)
+{
+	nano::transport::socket_queue queue{ 1024 };
+	for (int i = 0; i < 200; ++i)
+	{
+		ASSERT_TRUE (queue.insert (nano::shared_const_buffer{ std::vector<uint8_t> (200) }, nullptr, nano::transport::traffic_type::vote));
+	}
+	for (int i = 0; i < 10; ++i)
+	{
+		ASSERT_TRUE (queue.insert (nano::shared_const_buffer{ std::vector<uint8_t> (4 * 1024) }, nullptr, nano::transport::traffic_type::bootstrap));
+	}
+
+	// Bootstrap gets its share while votes are still queued instead of waiting for them to drain
+	std::size_t votes = 0;
+	std::size_t bootstrap = 0;
+	while (bootstrap == 0)
+	{
+		auto next = queue.pop ();
+		ASSERT_TRUE (next);
+		(next->type == nano::transport::traffic_type::vote ? votes : bootstrap) += 1;
+	}
+	ASSERT_LT (votes, 200);
+	// Votes earn four times the bytes per round bootstrap does
+	ASSERT_EQ (votes, queue.config.quantum[nano::transport::traffic_type::vote] / 200);
+
+	while (auto next = queue.pop ())
+	{
+		(next->type == nano::transport::traffic_type::vote ? votes : bootstrap) += 1;
+	}
+	ASSERT_EQ (200, votes);
+	ASSERT_EQ (10, bootstrap);
+	ASSERT_TRUE (queue.empty ());
+}
+
+TEST (socket_queue, byte_budget)
+{
+	nano::transport::socket_queue_config config;
+	config.max_bytes[nano::transport::traffic_type::block] = 1000;
+	nano::transport::socket_queue queue{ 1024, config };
+
+	// Oversized messages are accepted into an empty queue
+	ASSERT_FALSE (queue.max (nano::transport::traffic_type::block, 2000));
+	ASSERT_TRUE (queue.insert (nano::shared_const_buffer{ std::vector<uint8_t> (2000) }, nullptr, nano::transport::traffic_type::block));
+	// Senders see the exhausted budget before writing, even for messages that must not be dropped
+	ASSERT_TRUE (queue.max (nano::transport::traffic_type::block, 100));
+	ASSERT_TRUE (queue.full (nano::transport::traffic_type::block, 100));
+	ASSERT_FALSE (queue.insert (nano::shared_const_buffer{ std::vector<uint8_t> (100) }, nullptr, nano::transport::traffic_type::block));
+	// Other traffic types have their own budget
+	ASSERT_TRUE (queue.insert (nano::shared_const_buffer{ std::vector<uint8_t> (100) }, nullptr, nano::transport::traffic_type::vote));
+	ASSERT_TRUE (queue.pop ());
+	ASSERT_TRUE (queue.pop ());
+	ASSERT_TRUE (queue.insert (nano::shared_const_buffer{ std::vector<uint8_t> (600) }, nullptr, nano::transport::traffic_type::block));
+	ASSERT_FALSE (queue.insert (nano::shared_const_buffer{ std::vector<uint8_t> (600) }, nullptr, nano::transport::traffic_type::block));
+}
+
 /**
  * Check that the socket correctly handles a tcp_io_timeout during tcp connect
  * Steps:
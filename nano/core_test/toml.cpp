@@ -170,6 +170,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.external_address, defaults.node.external_address);
 	ASSERT_EQ (conf.node.external_port, defaults.node.external_port);
 	ASSERT_EQ (conf.node.io_threads, defaults.node.io_threads);
+	ASSERT_EQ (conf.node.io_shards, defaults.node.io_shards);
 	ASSERT_EQ (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_EQ (conf.node.network_threads, defaults.node.network_threads);
 	ASSERT_EQ (conf.node.background_threads, defaults.node.background_threads);
@@ -196,6 +197,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.max_queued_requests, defaults.node.max_queued_requests);
 	ASSERT_EQ (conf.node.request_aggregator_threads, defaults.node.request_aggregator_threads);
 	ASSERT_EQ (conf.node.max_unchecked_blocks, defaults.node.max_unchecked_blocks);
+	ASSERT_EQ (conf.node.block_cache_size, defaults.node.block_cache_size);
 	ASSERT_EQ (conf.node.backlog_scan_batch_size, defaults.node.backlog_scan_batch_size);
 	ASSERT_EQ (conf.node.backlog_scan_frequency, defaults.node.backlog_scan_frequency);
 
@@ -258,6 +260,17 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.block_processor.priority_live, defaults.node.block_processor.priority_live);
 	ASSERT_EQ (conf.node.block_processor.priority_bootstrap, defaults.node.block_processor.priority_bootstrap);
 	ASSERT_EQ (conf.node.block_processor.priority_local, defaults.node.block_processor.priority_local);
+	ASSERT_EQ (conf.node.block_processor.batch_target_time, defaults.node.block_processor.batch_target_time);
+	ASSERT_EQ (conf.node.block_processor.batch_min_size, defaults.node.block_processor.batch_min_size);
+	ASSERT_EQ (conf.node.block_processor.batch_max_size, defaults.node.block_processor.batch_max_size);
+	ASSERT_EQ (conf.node.block_processor.pipeline, defaults.node.block_processor.pipeline);
+	ASSERT_EQ (conf.node.block_processor.prefetch, defaults.node.block_processor.prefetch);
+
+	ASSERT_EQ (conf.node.confirming_set.batch_target_time, defaults.node.confirming_set.batch_target_time);
+	ASSERT_EQ (conf.node.confirming_set.batch_min_size, defaults.node.confirming_set.batch_min_size);
+	ASSERT_EQ (conf.node.confirming_set.batch_max_size, defaults.node.confirming_set.batch_max_size);
+	ASSERT_EQ (conf.node.confirming_set.cementing_chunk_size, defaults.node.confirming_set.cementing_chunk_size);
+	ASSERT_EQ (conf.node.confirming_set.resolver_threads, defaults.node.confirming_set.resolver_threads);
 
 	ASSERT_EQ (conf.node.vote_processor.max_pr_queue, defaults.node.vote_processor.max_pr_queue);
 	ASSERT_EQ (conf.node.vote_processor.max_non_pr_queue, defaults.node.vote_processor.max_non_pr_queue);
@@ -275,6 +288,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 
 	ASSERT_EQ (conf.node.message_processor.threads, defaults.node.message_processor.threads);
 	ASSERT_EQ (conf.node.message_processor.max_queue, defaults.node.message_processor.max_queue);
+	ASSERT_EQ (conf.node.message_processor.staging, defaults.node.message_processor.staging);
+	ASSERT_EQ (conf.node.message_processor.max_staging, defaults.node.message_processor.max_staging);
 }
 
 TEST (toml, optional_child)
@@ -420,6 +435,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	external_address = "0:0:0:0:0:ffff:7f01:101"
 	external_port = 999
 	io_threads = 999
+	io_shards = 3
 	lmdb_max_dbs = 999
 	network_threads = 999
 	background_threads = 999
@@ -446,6 +462,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	max_queued_requests = 999
 	request_aggregator_threads = 999
 	max_unchecked_blocks = 999
+	block_cache_size = 999
 	frontiers_confirmation = "always"
 	backlog_scan_batch_size = 999
 	backlog_scan_frequency = 999
@@ -456,6 +473,18 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	priority_live = 999
 	priority_bootstrap = 999
 	priority_local = 999
+	batch_target_time = 999
+	batch_min_size = 999
+	batch_max_size = 999
+	pipeline = true
+	prefetch = false
+
+	[node.confirming_set]
+	batch_target_time = 999
+	batch_min_size = 999
+	batch_max_size = 999
+	cementing_chunk_size = 999
+	resolver_threads = 999
 
 	[node.active_elections]
 	size = 999
@@ -589,6 +618,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	[node.message_processor]
 	threads = 999
 	max_queue = 999
+	staging = false
+	max_staging = 999
 
 	[opencl]
 	device = 999
@@ -641,8 +672,10 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.external_address, defaults.node.external_address);
 	ASSERT_NE (conf.node.external_port, defaults.node.external_port);
 	ASSERT_NE (conf.node.io_threads, defaults.node.io_threads);
+	ASSERT_NE (conf.node.io_shards, defaults.node.io_shards);
 	ASSERT_NE (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_NE (conf.node.max_unchecked_blocks, defaults.node.max_unchecked_blocks);
+	ASSERT_NE (conf.node.block_cache_size, defaults.node.block_cache_size);
 	ASSERT_NE (conf.node.frontiers_confirmation, defaults.node.frontiers_confirmation);
 	ASSERT_NE (conf.node.network_threads, defaults.node.network_threads);
 	ASSERT_NE (conf.node.background_threads, defaults.node.background_threads);
@@ -733,6 +766,17 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.block_processor.priority_live, defaults.node.block_processor.priority_live);
 	ASSERT_NE (conf.node.block_processor.priority_bootstrap, defaults.node.block_processor.priority_bootstrap);
 	ASSERT_NE (conf.node.block_processor.priority_local, defaults.node.block_processor.priority_local);
+	ASSERT_NE (conf.node.block_processor.batch_target_time, defaults.node.block_processor.batch_target_time);
+	ASSERT_NE (conf.node.block_processor.batch_min_size, defaults.node.block_processor.batch_min_size);
+	ASSERT_NE (conf.node.block_processor.batch_max_size, defaults.node.block_processor.batch_max_size);
+	ASSERT_NE (conf.node.block_processor.pipeline, defaults.node.block_processor.pipeline);
+	ASSERT_NE (conf.node.block_processor.prefetch, defaults.node.block_processor.prefetch);
+
+	ASSERT_NE (conf.node.confirming_set.batch_target_time, defaults.node.confirming_set.batch_target_time);
+	ASSERT_NE (conf.node.confirming_set.batch_min_size, defaults.node.confirming_set.batch_min_size);
+	ASSERT_NE (conf.node.confirming_set.batch_max_size, defaults.node.confirming_set.batch_max_size);
+	ASSERT_NE (conf.node.confirming_set.cementing_chunk_size, defaults.node.confirming_set.cementing_chunk_size);
+	ASSERT_NE (conf.node.confirming_set.resolver_threads, defaults.node.confirming_set.resolver_threads);
 
 	ASSERT_NE (conf.node.vote_processor.max_pr_queue, defaults.node.vote_processor.max_pr_queue);
 	ASSERT_NE (conf.node.vote_processor.max_non_pr_queue, defaults.node.vote_processor.max_non_pr_queue);
@@ -750,6 +794,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 
 	ASSERT_NE (conf.node.message_processor.threads, defaults.node.message_processor.threads);
 	ASSERT_NE (conf.node.message_processor.max_queue, defaults.node.message_processor.max_queue);
+	ASSERT_NE (conf.node.message_processor.staging, defaults.node.message_processor.staging);
+	ASSERT_NE (conf.node.message_processor.max_staging, defaults.node.message_processor.max_staging);
 }
 
 /** There should be no required values **/
@@ -1,4 +1,6 @@
+#include <nano/lib/mpsc_queue.hpp>
 #include <nano/lib/optional_ptr.hpp>
+#include <nano/lib/random.hpp>
 #include <nano/lib/rate_limiting.hpp>
 #include <nano/lib/thread_pool.hpp>
 #include <nano/lib/timer.hpp>
@@ -12,6 +14,8 @@
 
 #include <fstream>
 #include <future>
+#include <numeric>
+#include <unordered_set>
 
 using namespace std::chrono_literals;
 
@@ -119,6 +123,79 @@ TEST (rate, busy_spin)
 	ASSERT_EQ (counter, 6);
 }
 
+TEST (rate, concurrent)
+{
+	// Refill is slow enough that the test only sees the initial burst
+	nano::rate::token_bucket bucket (10000, 1);
+
+	std::atomic<std::size_t> passed{ 0 };
+	std::vector<std::thread> threads;
+	for (auto i = 0; i < 8; ++i)
+	{
+		threads.emplace_back ([&bucket, &passed] () {
+			for (auto j = 0; j < 5000; ++j)
+			{
+				if (bucket.try_consume ())
+				{
+					++passed;
+				}
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+
+	// No token is handed out twice, none is lost
+	ASSERT_GE (passed, 10000);
+	ASSERT_LE (passed, 10000 + 5);
+	ASSERT_EQ (bucket.largest_burst (), 10000);
+}
+
+TEST (mpsc_queue, concurrent)
+{
+	nano::mpsc_queue<std::pair<int, int>> queue;
+	ASSERT_TRUE (queue.empty ());
+
+	int const producers = 4;
+	int const count = 10000;
+	std::vector<std::thread> threads;
+	for (auto producer = 0; producer < producers; ++producer)
+	{
+		threads.emplace_back ([&queue, producer] () {
+			for (auto i = 0; i < count; ++i)
+			{
+				queue.push ({ producer, i });
+			}
+		});
+	}
+
+	// Consume while producers are running, every item arrives exactly once and in order per producer
+	std::vector<int> next (producers, 0);
+	std::vector<std::pair<int, int>> items;
+	auto consume = [&] () {
+		items.clear ();
+		queue.pop_all (items);
+		for (auto const & [producer, value] : items)
+		{
+			ASSERT_EQ (next[producer], value);
+			++next[producer];
+		}
+	};
+	while (std::any_of (next.begin (), next.end (), [] (int value) { return value < count; }))
+	{
+		consume ();
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	consume ();
+	ASSERT_TRUE (queue.empty ());
+	ASSERT_TRUE (items.empty ());
+}
+
 TEST (optional_ptr, basic)
 {
 	struct valtype
@@ -360,3 +437,22 @@ TEST (pending_key, sorting)
 	ASSERT_EQ (std::hash<nano::pending_key>{}(one), std::hash<nano::pending_key>{}(one_same));
 	ASSERT_NE (std::hash<nano::pending_key>{}(one), std::hash<nano::pending_key>{}(two));
 }
+
+TEST (random_sample, distinct)
+{
+	nano::random_generator rng;
+	std::vector<int> items (100);
+	std::iota (items.begin (), items.end (), 0);
+
+	std::vector<int> sample;
+	nano::random_sample (items, 10, rng, [] (int) { return true; }, [&sample] (int item) { sample.push_back (item); });
+	ASSERT_EQ (10, sample.size ());
+	ASSERT_EQ (10, std::unordered_set<int> (sample.begin (), sample.end ()).size ());
+
+	// Rejected elements are skipped and the sample is limited to what is accepted
+	sample.clear ();
+	nano::random_sample (items, 100, rng, [] (int item) { return item % 2 == 0; }, [&sample] (int item) { sample.push_back (item); });
+	ASSERT_EQ (50, sample.size ());
+	ASSERT_EQ (50, std::unordered_set<int> (sample.begin (), sample.end ()).size ());
+	ASSERT_TRUE (std::all_of (sample.begin (), sample.end (), [] (int item) { return item % 2 == 0; }));
+}
@@ -77,6 +77,31 @@ TEST (vote_processor, invalid_signature)
 	ASSERT_TIMELY_EQ (5s, 2, election->votes ().size ());
 }
 
+// Votes are verified as a batch, an invalid vote must not affect the other votes of the batch
+TEST (vote_processor, invalid_signature_batch)
+{
+	nano::test::system system{ 1 };
+	auto & node = *system.nodes[0];
+	auto chain = nano::test::setup_chain (system, node, 1, nano::dev::genesis_key, false);
+	auto channel = std::make_shared<nano::transport::inproc::channel> (node, node);
+
+	std::vector<std::shared_ptr<nano::vote>> votes;
+	for (int i = 0; i < 16; ++i)
+	{
+		nano::keypair key;
+		votes.push_back (std::make_shared<nano::vote> (key.pub, key.prv, nano::vote::timestamp_min * 1, 0, std::vector<nano::block_hash>{ chain[0]->hash () }));
+	}
+	votes[7] = std::make_shared<nano::vote> (*votes[7]);
+	votes[7]->signature.bytes[0] ^= 1;
+
+	for (auto const & vote : votes)
+	{
+		ASSERT_TRUE (node.vote_processor.vote (vote, channel));
+	}
+	ASSERT_TIMELY_EQ (5s, node.stats.count (nano::stat::type::vote, nano::stat::detail::indeterminate), 15);
+	ASSERT_EQ (node.stats.count (nano::stat::type::vote, nano::stat::detail::invalid), 1);
+}
+
 TEST (vote_processor, overflow)
 {
 	nano::test::system system;
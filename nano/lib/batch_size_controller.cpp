@@ -0,0 +1,46 @@
+#include <nano/lib/batch_size_controller.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <algorithm>
+
+nano::batch_size_controller::batch_size_controller (std::chrono::microseconds target_a, std::size_t min_size_a, std::size_t max_size_a, std::size_t initial_size_a) :
+	target{ target_a },
+	min_size{ std::max<std::size_t> (min_size_a, 1) },
+	max_size{ std::max (max_size_a, min_size) },
+	current{ std::clamp (initial_size_a, min_size, max_size) }
+{
+	debug_assert (target.count () > 0);
+}
+
+std::size_t nano::batch_size_controller::size () const
+{
+	return current;
+}
+
+auto nano::batch_size_controller::update (std::size_t count, std::chrono::microseconds elapsed) -> decision
+{
+	if (count == 0)
+	{
+		return decision::keep;
+	}
+
+	// Leave some slack around the target so the size does not oscillate between batches
+	bool const too_slow = elapsed > target + target / 4;
+	bool const too_fast = elapsed < target - target / 4 && count >= current;
+	if (!too_slow && !too_fast)
+	{
+		return decision::keep;
+	}
+
+	// Size that would have hit the target at the measured per item cost, each step at most doubles or halves the size
+	auto const ideal = elapsed.count () > 0 ? static_cast<std::size_t> (static_cast<double> (count) * target.count () / elapsed.count ()) : count * 2;
+	auto const next = std::clamp (std::clamp (ideal, current / 2, current * 2), min_size, max_size);
+	if (next == current)
+	{
+		return decision::keep;
+	}
+
+	auto const result = next > current ? decision::increase : decision::decrease;
+	current = next;
+	return result;
+}
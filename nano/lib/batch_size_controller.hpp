@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace nano
+{
+/**
+ * Adjusts the number of items processed in a single write transaction so that the transaction is held for roughly the target time.
+ * Fast disks get larger batches, slow disks get smaller batches that release the write lock more often.
+ */
+class batch_size_controller final
+{
+public:
+	enum class decision
+	{
+		keep,
+		increase,
+		decrease,
+	};
+
+	batch_size_controller (std::chrono::microseconds target, std::size_t min_size, std::size_t max_size, std::size_t initial_size);
+
+	std::size_t size () const;
+
+	/**
+	 * Updates the batch size after `count` items were processed in `elapsed` time.
+	 * The batch only grows when it was full, a partially filled batch says nothing about how long a full one would take.
+	 */
+	decision update (std::size_t count, std::chrono::microseconds elapsed);
+
+private:
+	std::chrono::microseconds const target;
+	std::size_t const min_size;
+	std::size_t const max_size;
+	std::size_t current;
+};
+}
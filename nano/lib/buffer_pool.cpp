@@ -0,0 +1,169 @@
+#include <nano/lib/buffer_pool.hpp>
+#include <nano/lib/memory.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <algorithm>
+
+/*
+ * buffer_pool::thread_cache
+ */
+
+namespace
+{
+thread_local bool thread_cache_destroyed{ false };
+}
+
+class nano::buffer_pool::thread_cache final
+{
+public:
+	~thread_cache ()
+	{
+		thread_cache_destroyed = true;
+		// Hand everything back so buffers cached by exiting threads stay usable
+		for (auto index = 0u; index < cached.size (); ++index)
+		{
+			auto & size_class = nano::buffer_pool::instance ().classes[index];
+			nano::lock_guard<nano::mutex> guard{ size_class.mutex };
+			for (auto & entry : cached[index])
+			{
+				if (size_class.free.size () < max_pooled[index])
+				{
+					size_class.free.push_back (std::move (entry));
+				}
+				else
+				{
+					--size_class.pooled;
+				}
+			}
+		}
+	}
+
+	std::array<std::vector<entry_t>, size_classes.size ()> cached;
+};
+
+/*
+ * buffer_pool
+ */
+
+nano::buffer_pool & nano::buffer_pool::instance ()
+{
+	static auto * pool = new nano::buffer_pool{};
+	return *pool;
+}
+
+nano::buffer_pool::thread_cache * nano::buffer_pool::local_cache ()
+{
+	if (thread_cache_destroyed)
+	{
+		return nullptr;
+	}
+	thread_local thread_cache cache;
+	return &cache;
+}
+
+std::size_t nano::buffer_pool::class_for_size (std::size_t size)
+{
+	return std::lower_bound (size_classes.begin (), size_classes.end (), size) - size_classes.begin ();
+}
+
+std::size_t nano::buffer_pool::class_for_capacity (std::size_t capacity)
+{
+	// Do not hold on to buffers which grew far past every class
+	if (capacity > 2 * size_classes.back ())
+	{
+		return size_classes.size ();
+	}
+	auto index = std::upper_bound (size_classes.begin (), size_classes.end (), capacity) - size_classes.begin ();
+	return index == 0 ? size_classes.size () : index - 1;
+}
+
+nano::buffer_pool::buffer_t nano::buffer_pool::acquire (std::size_t size)
+{
+	auto const index = class_for_size (size);
+	if (index == size_classes.size () || !nano::get_use_memory_pools ())
+	{
+		auto result = std::make_shared<std::vector<uint8_t>> ();
+		result->reserve (size);
+		return result;
+	}
+
+	auto & size_class = classes[index];
+	entry_t entry;
+	auto * cache = local_cache ();
+	if (cache && !cache->cached[index].empty ())
+	{
+		entry = std::move (cache->cached[index].back ());
+		cache->cached[index].pop_back ();
+	}
+	else
+	{
+		nano::lock_guard<nano::mutex> guard{ size_class.mutex };
+		if (!size_class.free.empty ())
+		{
+			entry = std::move (size_class.free.back ());
+			size_class.free.pop_back ();
+		}
+	}
+	if (entry)
+	{
+		--size_class.pooled;
+		++size_class.hits;
+	}
+	else
+	{
+		entry = std::make_unique<std::vector<uint8_t>> ();
+		entry->reserve (size_classes[index]);
+		++size_class.misses;
+	}
+	++size_class.in_use;
+	debug_assert (entry->empty () && entry->capacity () >= size);
+	return buffer_t{ entry.release (), [index] (std::vector<uint8_t> * buffer) {
+						nano::buffer_pool::instance ().release (buffer, index);
+					} };
+}
+
+void nano::buffer_pool::release (std::vector<uint8_t> * buffer, std::size_t origin)
+{
+	entry_t entry{ buffer };
+	--classes[origin].in_use;
+	// Buffers may have grown while in use, they are filed by the largest class they can serve now
+	auto const index = class_for_capacity (entry->capacity ());
+	if (index == size_classes.size ())
+	{
+		return;
+	}
+
+	entry->clear ();
+	auto & size_class = classes[index];
+	++size_class.pooled;
+	auto * cache = local_cache ();
+	if (cache && cache->cached[index].size () < thread_cache_size)
+	{
+		cache->cached[index].push_back (std::move (entry));
+		return;
+	}
+	nano::lock_guard<nano::mutex> guard{ size_class.mutex };
+	if (size_class.free.size () < max_pooled[index])
+	{
+		size_class.free.push_back (std::move (entry));
+	}
+	else
+	{
+		--size_class.pooled;
+	}
+}
+
+std::unique_ptr<nano::container_info_component> nano::buffer_pool::collect_container_info (std::string const & name) const
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	for (auto index = 0u; index < size_classes.size (); ++index)
+	{
+		auto const & size_class = classes[index];
+		auto const suffix = std::to_string (size_classes[index]);
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pooled_" + suffix, size_class.pooled.load (), size_classes[index] }));
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "in_use_" + suffix, size_class.in_use.load (), size_classes[index] }));
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "hits_" + suffix, static_cast<std::size_t> (size_class.hits.load ()), 0 }));
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "misses_" + suffix, static_cast<std::size_t> (size_class.misses.load ()), 0 }));
+	}
+	return composite;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+class container_info_component;
+}
+
+namespace nano
+{
+/**
+ * Recycles the byte vectors backing network messages.
+ * Buffers are grouped into size classes by capacity and handed out as shared_ptrs which give the vector back to the pool once the last reference is dropped.
+ * Each thread keeps a few buffers per size class in front of the shared free lists, so io threads rarely touch the shared lists or the allocator.
+ */
+class buffer_pool final
+{
+public:
+	using buffer_t = std::shared_ptr<std::vector<uint8_t>>;
+
+	/** Capacities handed out: keepalive/publish/small votes, handshakes and telemetry, full confirm_ack and the realtime read buffer, the largest message */
+	static std::array<std::size_t, 4> constexpr size_classes{ 256, 1024, 9 * 1024, 66 * 1024 };
+	/** Buffers cached by each thread per size class */
+	static std::size_t constexpr thread_cache_size = 16;
+	/** Buffers kept in each shared free list, the rest is released to the allocator */
+	static std::array<std::size_t, 4> constexpr max_pooled{ 4096, 1024, 256, 64 };
+
+	/** Process wide pool, never destroyed so buffers can be released at any point during shutdown */
+	static buffer_pool & instance ();
+
+	/** Returns an empty vector with capacity of at least `size`. Sizes above the largest class are allocated without pooling */
+	buffer_t acquire (std::size_t size);
+
+	std::unique_ptr<nano::container_info_component> collect_container_info (std::string const & name) const;
+
+private:
+	buffer_pool () = default;
+
+	using entry_t = std::unique_ptr<std::vector<uint8_t>>;
+
+	class thread_cache;
+	/** Returns nullptr once the calling thread's cache has been destroyed */
+	static thread_cache * local_cache ();
+	void release (std::vector<uint8_t> *, std::size_t origin);
+	/** Returns the index of the smallest class fitting `size` or size_classes.size () if none does */
+	static std::size_t class_for_size (std::size_t size);
+	/** Returns the index of the largest class `capacity` can serve or size_classes.size () if none */
+	static std::size_t class_for_capacity (std::size_t capacity);
+
+	struct size_class
+	{
+		nano::mutex mutex;
+		std::vector<entry_t> free;
+		std::atomic<std::size_t> pooled{ 0 };
+		std::atomic<std::size_t> in_use{ 0 };
+		std::atomic<uint64_t> hits{ 0 };
+		std::atomic<uint64_t> misses{ 0 };
+	};
+	std::array<size_class, size_classes.size ()> classes;
+};
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace nano
+{
+/**
+ * Unbounded lock-free queue for many producers.
+ * Producers push single items with one compare and swap. Consumers take everything queued so far with a single exchange,
+ * so there is no per item synchronization between consumers and producers. Taken items are returned in push order.
+ * Several consumers are allowed, each one takes a disjoint set of items.
+ */
+template <typename T>
+class mpsc_queue final
+{
+private:
+	struct node
+	{
+		T value;
+		node * next;
+	};
+
+public:
+	mpsc_queue () = default;
+	mpsc_queue (mpsc_queue const &) = delete;
+	mpsc_queue & operator= (mpsc_queue const &) = delete;
+
+	~mpsc_queue ()
+	{
+		release (head.exchange (nullptr));
+	}
+
+	/** Returns true if the queue was empty before this push */
+	bool push (T value)
+	{
+		auto item = new node{ std::move (value), nullptr };
+		auto expected = head.load (std::memory_order_relaxed);
+		do
+		{
+			item->next = expected;
+		} while (!head.compare_exchange_weak (expected, item, std::memory_order_release, std::memory_order_relaxed));
+		// `item` may already be taken by a consumer here, only the local copy of the previous head is safe to read
+		return expected == nullptr;
+	}
+
+	/** Appends all queued items to `output`, oldest first. Returns the number of items taken */
+	template <typename Container>
+	std::size_t pop_all (Container & output)
+	{
+		// Items are linked newest first, reverse the list to restore push order
+		node * reversed = nullptr;
+		for (auto item = head.exchange (nullptr, std::memory_order_acquire); item != nullptr;)
+		{
+			auto next = item->next;
+			item->next = reversed;
+			reversed = item;
+			item = next;
+		}
+		std::size_t count = 0;
+		while (reversed != nullptr)
+		{
+			output.push_back (std::move (reversed->value));
+			auto next = reversed->next;
+			delete reversed;
+			reversed = next;
+			++count;
+		}
+		return count;
+	}
+
+	bool empty () const
+	{
+		return head.load (std::memory_order_relaxed) == nullptr;
+	}
+
+private:
+	static void release (node * item)
+	{
+		while (item != nullptr)
+		{
+			auto next = item->next;
+			delete item;
+			item = next;
+		}
+	}
+
+	std::atomic<node *> head{ nullptr };
+};
+}
@@ -428,6 +428,11 @@ bool nano::validate_message (nano::public_key const & public_key, nano::uint256_
 	return validate_message (public_key, message.bytes.data (), sizeof (message.bytes), signature);
 }
 
+void nano::validate_message_batch (unsigned char const ** m, size_t * mlen, unsigned char const ** pk, unsigned char const ** RS, size_t num, int * valid)
+{
+	ed25519_sign_open_batch (m, mlen, pk, RS, num, valid);
+}
+
 nano::uint128_union::uint128_union (std::string const & string_a)
 {
 	auto error (decode_hex (string_a));
@@ -3,3 +3,7 @@
 void nano::work_thread_reprioritize ()
 {
 }
+
+void nano::thread_pin_to_core (unsigned core)
+{
+}
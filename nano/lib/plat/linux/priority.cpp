@@ -1,6 +1,7 @@
 #include <nano/lib/utility.hpp>
 
 #include <pthread.h>
+#include <sched.h>
 
 void nano::work_thread_reprioritize ()
 {
@@ -14,3 +15,12 @@ void nano::work_thread_reprioritize ()
 		(void)result;
 	}
 }
+
+void nano::thread_pin_to_core (unsigned core)
+{
+	cpu_set_t cpuset;
+	CPU_ZERO (&cpuset);
+	CPU_SET (core % CPU_SETSIZE, &cpuset);
+	auto result (pthread_setaffinity_np (pthread_self (), sizeof (cpuset), &cpuset));
+	(void)result;
+}
@@ -5,4 +5,9 @@ void work_thread_reprioritize ()
 {
 	SetThreadPriority (GetCurrentThread (), THREAD_MODE_BACKGROUND_BEGIN);
 }
+
+void thread_pin_to_core (unsigned core)
+{
+	SetThreadAffinityMask (GetCurrentThread (), DWORD_PTR{ 1 } << (core % (sizeof (DWORD_PTR) * 8)));
+}
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <random>
+#include <unordered_map>
+#include <vector>
 
 namespace nano
 {
@@ -28,4 +30,32 @@ private:
 	std::random_device device;
 	std::default_random_engine rng{ device () };
 };
+
+/**
+ * Passes up to `count` distinct elements of `items` accepted by `predicate` to `output`, in random order.
+ * Partial Fisher-Yates over a sparse permutation of indices, so only the elements drawn are touched: O(count) when most elements are accepted.
+ */
+template <typename T, typename Predicate, typename Output>
+void random_sample (std::vector<T> const & items, std::size_t count, nano::random_generator & rng, Predicate && predicate, Output && output)
+{
+	auto const size = items.size ();
+	// Positions swapped so far, any other position i still holds index i
+	std::unordered_map<std::size_t, std::size_t> swapped;
+	auto index_at = [&swapped] (std::size_t position) {
+		auto existing = swapped.find (position);
+		return existing != swapped.end () ? existing->second : position;
+	};
+	std::size_t accepted = 0;
+	for (std::size_t position = 0; position < size && accepted < count; ++position)
+	{
+		auto const pick = rng.random (position, size);
+		auto const index = index_at (pick);
+		swapped[pick] = index_at (position);
+		if (predicate (items[index]))
+		{
+			output (items[index]);
+			++accepted;
+		}
+	}
+}
 }
\ No newline at end of file
@@ -1,4 +1,3 @@
-#include <nano/lib/locks.hpp>
 #include <nano/lib/rate_limiting.hpp>
 #include <nano/lib/utility.hpp>
 
@@ -12,53 +11,86 @@ nano::rate::token_bucket::token_bucket (std::size_t max_token_count_a, std::size
 bool nano::rate::token_bucket::try_consume (unsigned tokens_required_a)
 {
 	debug_assert (tokens_required_a <= 1e9);
-	nano::lock_guard<nano::mutex> guard{ mutex };
 	refill ();
-	bool possible = current_size >= tokens_required_a;
-	if (possible)
-	{
-		current_size -= tokens_required_a;
-	}
-	else if (tokens_required_a == 1e9)
+
+	bool possible;
+	auto size = current_size.load ();
+	std::size_t updated;
+	do
 	{
-		current_size = 0;
-	}
+		possible = size >= tokens_required_a;
+		if (possible)
+		{
+			updated = size - tokens_required_a;
+		}
+		else if (tokens_required_a == 1e9)
+		{
+			updated = 0;
+		}
+		else
+		{
+			updated = size;
+			break; // Nothing to deduct
+		}
+	} while (!current_size.compare_exchange_weak (size, updated));
 
 	// Keep track of smallest observed bucket size so burst size can be computed (for tests and stats)
-	smallest_size = std::min (smallest_size, current_size);
+	update_smallest (updated);
 
 	return possible || refill_rate == unlimited_rate_sentinel;
 }
 
 void nano::rate::token_bucket::refill ()
 {
-	auto now (std::chrono::steady_clock::now ());
-	std::size_t tokens_to_add = static_cast<std::size_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (now - last_refill).count () / 1e9 * refill_rate);
-	// Only update if there are any tokens to add
-	if (tokens_to_add > 0)
+	auto const now_l = now ();
+	auto last = last_refill.load ();
+	if (now_l <= last)
 	{
-		current_size = std::min (current_size + tokens_to_add, max_token_count);
-		last_refill = std::chrono::steady_clock::now ();
+		return;
+	}
+	std::size_t tokens_to_add = static_cast<std::size_t> ((now_l - last) / 1e9 * refill_rate);
+	// Only update if there are any tokens to add. Threads racing over the same interval add them once, only the one advancing the timestamp does
+	if (tokens_to_add > 0 && last_refill.compare_exchange_strong (last, now_l))
+	{
+		auto const max = max_token_count.load ();
+		auto size = current_size.load ();
+		while (!current_size.compare_exchange_weak (size, std::min (size + tokens_to_add, max)))
+		{
+			// `size` was reloaded by the failed exchange, retry with it
+		}
 	}
 }
 
+void nano::rate::token_bucket::update_smallest (std::size_t size_a)
+{
+	auto smallest = smallest_size.load ();
+	while (size_a < smallest && !smallest_size.compare_exchange_weak (smallest, size_a))
+	{
+	}
+}
+
+int64_t nano::rate::token_bucket::now ()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
 std::size_t nano::rate::token_bucket::largest_burst () const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
 	return max_token_count - smallest_size;
 }
 
 void nano::rate::token_bucket::reset (std::size_t max_token_count_a, std::size_t refill_rate_a)
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-
 	// A token count of 0 indicates unlimited capacity. We use 1e9 as
 	// a sentinel, allowing largest burst to still be computed.
 	if (max_token_count_a == 0 || refill_rate_a == 0)
 	{
 		refill_rate_a = max_token_count_a = unlimited_rate_sentinel;
 	}
-	max_token_count = smallest_size = current_size = max_token_count_a;
+	// Not atomic as a whole, a consumer racing with a reset sees either limit
+	max_token_count = max_token_count_a;
+	smallest_size = max_token_count_a;
+	current_size = max_token_count_a;
 	refill_rate = refill_rate_a;
-	last_refill = std::chrono::steady_clock::now ();
+	last_refill = now ();
 }
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
-#include <mutex>
+#include <cstdint>
 
 namespace nano
 {
@@ -19,6 +20,10 @@ namespace rate
 	 * A bucket has low overhead and can be instantiated for various purposes, such as one
 	 * bucket per session, or one for bandwidth limiting. A token can represent bytes,
 	 * messages, or the cost of API invocations.
+	 *
+	 * The bucket is lock-free, it is shared by every thread sending to the network.
+	 * The refill is claimed by whichever thread advances the refill timestamp, tokens are then
+	 * added and consumed with compare and swap loops.
 	 */
 	class token_bucket
 	{
@@ -46,17 +51,18 @@ namespace rate
 
 	private:
 		void refill ();
+		void update_smallest (std::size_t size);
+		static int64_t now ();
 
 	private:
-		std::size_t max_token_count;
-		std::size_t refill_rate;
+		std::atomic<std::size_t> max_token_count;
+		std::atomic<std::size_t> refill_rate;
 
-		std::size_t current_size{ 0 };
+		std::atomic<std::size_t> current_size{ 0 };
 		/** The minimum observed bucket size, from which the largest burst can be derived */
-		std::size_t smallest_size{ 0 };
-		std::chrono::steady_clock::time_point last_refill;
-
-		mutable nano::mutex mutex;
+		std::atomic<std::size_t> smallest_size{ 0 };
+		/** Nanoseconds since the steady clock epoch */
+		std::atomic<int64_t> last_refill;
 
 		static std::size_t constexpr unlimited_rate_sentinel{ static_cast<std::size_t> (1e9) };
 	};
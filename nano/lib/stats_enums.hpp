@@ -127,6 +127,8 @@ enum class detail
 	queue,
 	overfill,
 	batch,
+	staging,
+	staging_overfill,
 
 	// error specific
 	insufficient_work,
@@ -161,11 +163,18 @@ enum class detail
 	balance_mismatch,
 	representative_mismatch,
 	block_position,
+	counter_corrected,
 
 	// blockprocessor
 	process_blocking,
 	process_blocking_timeout,
 	force,
+	signature_verified,
+	signature_unverified,
+	prechecked,
+	prefetch,
+	batch_size_increase,
+	batch_size_decrease,
 
 	// block source
 	live,
@@ -228,6 +237,7 @@ enum class detail
 	broadcast_vote,
 	broadcast_vote_normal,
 	broadcast_vote_final,
+	tally_recompute,
 	generate_vote,
 	generate_vote_normal,
 	generate_vote_final,
@@ -274,6 +284,7 @@ enum class detail
 	tcp_connect_error,
 	tcp_read_error,
 	tcp_write_error,
+	tcp_write_coalesced,
 
 	// tcp_listener
 	accept_success,
@@ -337,6 +348,7 @@ enum class detail
 
 	// duplicate
 	duplicate_publish_message,
+	duplicate_confirm_ack_message,
 
 	// telemetry
 	invalid_signature,
@@ -456,6 +468,9 @@ enum class detail
 	notify_cemented,
 	notify_already_cemented,
 	already_cemented,
+	cemented_chunk,
+	resolved,
+	resolved_stale,
 
 	// election_state
 	passive,
@@ -488,6 +503,17 @@ enum class sample
 	active_election_duration,
 	bootstrap_tag_duration,
 	rep_response_time,
+	block_processor_batch_size,
+	confirming_set_batch_size,
+	// Time messages spend in socket send queues, in milliseconds
+	queue_delay_generic,
+	queue_delay_bootstrap,
+	queue_delay_vote,
+	queue_delay_vote_final,
+	queue_delay_block,
+	queue_delay_telemetry,
+	// Messages moved from the message_processor staging queues per drain
+	message_processor_staging_depth,
 
 	_last // Must be the last enum
 };
@@ -22,6 +22,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::io_daemon:
 			thread_role_name_string = "I/O (daemon)";
 			break;
+		case nano::thread_role::name::io_shard:
+			thread_role_name_string = "I/O shard";
+			break;
 		case nano::thread_role::name::work:
 			thread_role_name_string = "Work pool";
 			break;
@@ -37,6 +40,12 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::block_processing:
 			thread_role_name_string = "Blck processing";
 			break;
+		case nano::thread_role::name::block_processing_precheck:
+			thread_role_name_string = "Blck precheck";
+			break;
+		case nano::thread_role::name::block_processing_notifications:
+			thread_role_name_string = "Blck notif";
+			break;
 		case nano::thread_role::name::request_loop:
 			thread_role_name_string = "Request loop";
 			break;
@@ -67,6 +76,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::confirmation_height_notifications:
 			thread_role_name_string = "Conf notif";
 			break;
+		case nano::thread_role::name::confirmation_height_resolver:
+			thread_role_name_string = "Conf resolver";
+			break;
 		case nano::thread_role::name::worker:
 			thread_role_name_string = "Worker";
 			break;
@@ -12,11 +12,14 @@ enum class name
 	unknown,
 	io,
 	io_daemon,
+	io_shard,
 	work,
 	message_processing,
 	vote_processing,
 	vote_cache_processing,
 	block_processing,
+	block_processing_precheck,
+	block_processing_notifications,
 	request_loop,
 	wallet_actions,
 	bootstrap_initiator,
@@ -27,6 +30,7 @@ enum class name
 	rpc_process_container,
 	confirmation_height_processing,
 	confirmation_height_notifications,
+	confirmation_height_resolver,
 	worker,
 	bootstrap_worker,
 	wallet_worker,
@@ -101,6 +101,9 @@ private:
 // Lower priority of calling work generating thread
 void work_thread_reprioritize ();
 
+// Restrict calling thread to a single CPU core, best effort and a no-op where unsupported
+void thread_pin_to_core (unsigned core);
+
 /*
  * Functions for managing filesystem permissions, platform specific
  */
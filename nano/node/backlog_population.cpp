@@ -96,21 +96,25 @@ void nano::backlog_population::populate_backlog (nano::unique_lock<nano::mutex>
 			auto transaction = ledger.tx_begin_read ();
 
 			auto count = 0u;
-			auto i = ledger.store.account.begin (transaction, next);
-			auto const end = ledger.store.account.end ();
-			for (; i != end && count < chunk_size; ++i, ++count, ++total)
-			{
+			done = true;
+			ledger.store.account.for_each_range (transaction, next, 0, [&] (nano::account const & account, nano::account_info const & account_info) {
+				if (count >= chunk_size)
+				{
+					// More accounts remain past this chunk
+					done = false;
+					return false;
+				}
 				transaction.refresh_if_needed ();
 
 				stats.inc (nano::stat::type::backlog, nano::stat::detail::total);
 
-				auto const & account = i->first;
-				auto const & account_info = i->second;
 				activate (transaction, account, account_info);
 
 				next = account.number () + 1;
-			}
-			done = ledger.store.account.begin (transaction, next) == end;
+				++count;
+				++total;
+				return true;
+			});
 		}
 
 		lock.lock ();
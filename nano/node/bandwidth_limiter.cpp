@@ -63,6 +63,10 @@ nano::bandwidth_limit_type nano::to_bandwidth_limit_type (const nano::transport:
 	switch (traffic_type)
 	{
 		case nano::transport::traffic_type::generic:
+		case nano::transport::traffic_type::vote:
+		case nano::transport::traffic_type::vote_final:
+		case nano::transport::traffic_type::block:
+		case nano::transport::traffic_type::telemetry:
 			return nano::bandwidth_limit_type::standard;
 			break;
 		case nano::transport::traffic_type::bootstrap:
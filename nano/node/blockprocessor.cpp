@@ -6,10 +6,12 @@
 #include <nano/node/blockprocessor.hpp>
 #include <nano/node/local_vote_history.hpp>
 #include <nano/node/node.hpp>
+#include <nano/node/signatures.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/store/component.hpp>
 
+#include <algorithm>
 #include <utility>
 
 /*
@@ -37,10 +39,25 @@ void nano::block_processor::context::set_result (result_t const & result)
  * block_processor
  */
 
+namespace
+{
+nano::batch_size_controller make_batch_size_controller (nano::block_processor_config const & config, nano::node_flags const & flags)
+{
+	// A batch size set on the command line disables adapting
+	if (flags.block_processor_batch_size != 0)
+	{
+		return { std::chrono::milliseconds{ config.batch_target_time }, flags.block_processor_batch_size, flags.block_processor_batch_size, flags.block_processor_batch_size };
+	}
+	return { std::chrono::milliseconds{ config.batch_target_time }, config.batch_min_size, config.batch_max_size, 256 };
+}
+}
+
 nano::block_processor::block_processor (nano::node & node_a) :
 	config{ node_a.config.block_processor },
 	node (node_a),
-	next_log (std::chrono::steady_clock::now ())
+	next_log (std::chrono::steady_clock::now ()),
+	batch_size{ make_batch_size_controller (config, node_a.flags) },
+	notification_workers{ 1, nano::thread_role::name::block_processing_notifications }
 {
 	batch_processed.add ([this] (auto const & items) {
 		// For every batch item: notify the 'processed' observer.
@@ -79,8 +96,9 @@ nano::block_processor::block_processor (nano::node & node_a) :
 
 nano::block_processor::~block_processor ()
 {
-	// Thread must be stopped before destruction
+	// Threads must be stopped before destruction
 	debug_assert (!thread.joinable ());
+	debug_assert (!precheck_thread.joinable ());
 }
 
 void nano::block_processor::start ()
@@ -91,6 +109,14 @@ void nano::block_processor::start ()
 		nano::thread_role::set (nano::thread_role::name::block_processing);
 		run ();
 	});
+
+	if (config.pipeline)
+	{
+		precheck_thread = std::thread ([this] () {
+			nano::thread_role::set (nano::thread_role::name::block_processing_precheck);
+			run_precheck ();
+		});
+	}
 }
 
 void nano::block_processor::stop ()
@@ -104,13 +130,18 @@ void nano::block_processor::stop ()
 	{
 		thread.join ();
 	}
+	if (precheck_thread.joinable ())
+	{
+		precheck_thread.join ();
+	}
+	notification_workers.stop ();
 }
 
 // TODO: Remove and replace all checks with calls to size (block_source)
 std::size_t nano::block_processor::size () const
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
-	return queue.size ();
+	return queue.size () + (prepared ? prepared->size () : 0);
 }
 
 std::size_t nano::block_processor::size (nano::block_source source) const
@@ -229,7 +260,8 @@ void nano::block_processor::run ()
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped)
 	{
-		if (!queue.empty ())
+		// In pipelined mode batches are dequeued by the precheck thread
+		if (config.pipeline ? prepared.has_value () : !queue.empty ())
 		{
 			// TODO: Cleaner periodical logging
 			if (should_log ())
@@ -239,7 +271,7 @@ void nano::block_processor::run ()
 				queue.size ({ nano::block_source::forced }));
 			}
 
-			auto processed = process_batch (lock);
+			auto processed = config.pipeline ? process_prepared (lock) : process_batch (lock);
 			debug_assert (!lock.owns_lock ());
 
 			// Set results for futures when not holding the lock
@@ -248,7 +280,7 @@ void nano::block_processor::run ()
 				context.set_result (result);
 			}
 
-			batch_processed.notify (processed);
+			notify_processed (std::move (processed));
 
 			lock.lock ();
 		}
@@ -308,13 +340,45 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 	debug_assert (!mutex.try_lock ());
 	debug_assert (!queue.empty ());
 
-	auto batch = next_batch (256);
+	auto batch = next_batch (batch_size.size ());
+
+	lock.unlock ();
+
+	// Signature checks are the most CPU intensive part of processing, do them in parallel before taking the write lock
+	verify_signatures (batch);
+	prefetch (batch);
+
+	return commit_batch (batch);
+}
+
+auto nano::block_processor::process_prepared (nano::unique_lock<nano::mutex> & lock) -> processed_batch_t
+{
+	debug_assert (lock.owns_lock ());
+	debug_assert (prepared);
+
+	auto batch = std::move (*prepared);
+	prepared.reset ();
+
+	// Everything committed before this batch is visible to read transactions started from now on
+	in_flight.clear ();
+	in_flight_forced = false;
+	for (auto const & ctx : batch)
+	{
+		in_flight.insert (ctx.block->hash ());
+		in_flight_forced = in_flight_forced || ctx.source == nano::block_source::forced;
+	}
 
 	lock.unlock ();
+	condition.notify_all (); // Wake up the precheck thread
+
+	return commit_batch (batch);
+}
 
+auto nano::block_processor::commit_batch (std::deque<context> & batch) -> processed_batch_t
+{
 	auto transaction = node.ledger.tx_begin_write ({ tables::accounts, tables::blocks, tables::pending, tables::rep_weights }, nano::store::writer::blockprocessor);
 
-	nano::timer<std::chrono::milliseconds> timer;
+	nano::timer<std::chrono::microseconds> timer;
 	timer.start ();
 
 	// Processing blocks
@@ -341,11 +405,14 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 		processed.emplace_back (result, std::move (ctx));
 	}
 
-	if (number_of_blocks_processed != 0 && timer.stop () > std::chrono::milliseconds (100))
+	auto const elapsed = timer.stop ();
+	if (number_of_blocks_processed != 0 && elapsed > std::chrono::milliseconds (100))
 	{
 		node.logger.debug (nano::log::type::blockprocessor, "Processed {} blocks ({} forced) in {} {}", number_of_blocks_processed, number_of_forced_processed, timer.value ().count (), timer.unit ());
 	}
 
+	update_batch_size (number_of_blocks_processed, elapsed);
+
 	return processed;
 }
 
@@ -353,7 +420,7 @@ nano::block_status nano::block_processor::process_one (secure::write_transaction
 {
 	auto block = context.block;
 	auto const hash = block->hash ();
-	nano::block_status result = node.ledger.process (transaction_a, block);
+	nano::block_status result = context.prechecked ? *context.prechecked : node.ledger.process (transaction_a, block, context.verification);
 
 	node.stats.inc (nano::stat::type::blockprocessor_result, to_stat_detail (result));
 	node.stats.inc (nano::stat::type::blockprocessor_source, to_stat_detail (context.source));
@@ -446,6 +513,239 @@ nano::block_status nano::block_processor::process_one (secure::write_transaction
 	return result;
 }
 
+void nano::block_processor::update_batch_size (size_t count, std::chrono::microseconds elapsed)
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	auto const decision = batch_size.update (count, elapsed);
+	auto const size = batch_size.size ();
+	lock.unlock ();
+
+	switch (decision)
+	{
+		case nano::batch_size_controller::decision::increase:
+			node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::batch_size_increase);
+			break;
+		case nano::batch_size_controller::decision::decrease:
+			node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::batch_size_decrease);
+			break;
+		case nano::batch_size_controller::decision::keep:
+			break;
+	}
+	node.stats.sample (nano::stat::sample::block_processor_batch_size, size, { config.batch_min_size, config.batch_max_size });
+}
+
+void nano::block_processor::notify_processed (processed_batch_t && processed)
+{
+	if (!config.pipeline)
+	{
+		batch_processed.notify (processed);
+		return;
+	}
+
+	// Observers run at most one batch behind, wait for the previous batch before queuing the next one
+	{
+		nano::unique_lock<nano::mutex> lock{ mutex };
+		condition.wait (lock, [this] { return stopped || pending_notifications == 0; });
+		++pending_notifications;
+	}
+
+	// Contexts hold move-only promises, wrap in a shared pointer to make the task copyable
+	auto shared = std::make_shared<processed_batch_t> (std::move (processed));
+	notification_workers.push_task ([this, shared] () {
+		batch_processed.notify (*shared);
+		{
+			nano::lock_guard<nano::mutex> guard{ mutex };
+			--pending_notifications;
+		}
+		condition.notify_all ();
+	});
+}
+
+void nano::block_processor::run_precheck ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		if (!queue.empty () && !prepared)
+		{
+			auto batch = next_batch (batch_size.size ());
+			auto exclusions = in_flight;
+			auto rollbacks = in_flight_forced;
+
+			lock.unlock ();
+
+			verify_signatures (batch);
+			precheck (batch, exclusions, rollbacks);
+			prefetch (batch);
+
+			lock.lock ();
+
+			prepared = std::move (batch);
+			condition.notify_all ();
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+void nano::block_processor::precheck (std::deque<context> & batch, std::unordered_set<nano::block_hash> const & exclusions_a, bool const rollbacks)
+{
+	// Forced blocks roll back ledger state the precheck would be based on
+	if (std::any_of (batch.begin (), batch.end (), [] (auto const & ctx) { return ctx.source == nano::block_source::forced; }))
+	{
+		return;
+	}
+
+	// Blocks may depend on blocks earlier in the same batch
+	auto exclusions = exclusions_a;
+	for (auto const & ctx : batch)
+	{
+		exclusions.insert (ctx.block->hash ());
+	}
+
+	auto transaction = node.ledger.tx_begin_read ();
+	for (auto & ctx : batch)
+	{
+		transaction.refresh_if_needed ();
+
+		ctx.prechecked = precheck_one (transaction, ctx, exclusions, rollbacks);
+		if (ctx.prechecked)
+		{
+			node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::prechecked);
+		}
+	}
+}
+
+std::optional<nano::block_status> nano::block_processor::precheck_one (secure::transaction const & transaction, context const & ctx, std::unordered_set<nano::block_hash> const & exclusions, bool const rollbacks)
+{
+	auto const & block = *ctx.block;
+
+	// Existing blocks are reported as old regardless of block type. Safe, as all batches that were committed before are visible,
+	// unless the batch being committed rolls back blocks this transaction still sees
+	if (node.ledger.any.block_exists_or_pruned (transaction, block.hash ()))
+	{
+		return rollbacks ? std::nullopt : std::optional{ nano::block_status::old };
+	}
+
+	// A missing previous block is only conclusive when it cannot be inserted by the batch being committed or this batch,
+	// and when the ledger would not report another status first
+	auto const previous = block.previous ();
+	if (previous.is_zero () || exclusions.contains (previous))
+	{
+		return std::nullopt;
+	}
+	switch (block.type ())
+	{
+		case nano::block_type::send:
+		case nano::block_type::receive:
+		case nano::block_type::change:
+			// Previous block is checked right after checking for existing blocks
+			break;
+		case nano::block_type::state:
+			// Previous block is checked after the signature and burn account checks. Epoch blocks follow different rules
+			if (ctx.verification != nano::signature_verification::valid || block.account_field ().value ().is_zero () || node.ledger.is_epoch_link (block.link_field ().value ()))
+			{
+				return std::nullopt;
+			}
+			break;
+		default:
+			return std::nullopt;
+	}
+	if (!node.ledger.any.block_exists (transaction, previous))
+	{
+		return nano::block_status::gap_previous;
+	}
+	return std::nullopt;
+}
+
+void nano::block_processor::verify_signatures (std::deque<context> & batch)
+{
+	nano::signature_check_set check;
+	check.reserve (batch.size ());
+
+	// Contexts and the signer kind of each entry in the check set
+	std::vector<std::pair<context *, nano::signature_verification>> entries;
+	entries.reserve (batch.size ());
+
+	for (auto & ctx : batch)
+	{
+		auto const & block = *ctx.block;
+		switch (block.type ())
+		{
+			// Legacy send, receive and change blocks are signed by the account of their previous block, which requires a ledger lookup
+			case nano::block_type::open:
+			case nano::block_type::state:
+			{
+				auto const hash = block.hash ();
+				check.add (block.account_field ().value (), hash, block.block_signature ());
+				entries.emplace_back (&ctx, nano::signature_verification::valid);
+
+				// Blocks with an epoch link are either epoch blocks or regular sends to the epoch link account
+				auto const link = block.link_field ();
+				if (link && node.ledger.is_epoch_link (link.value ()))
+				{
+					check.add (node.ledger.epoch_signer (link.value ()), hash, block.block_signature ());
+					entries.emplace_back (&ctx, nano::signature_verification::valid_epoch);
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	if (check.empty ())
+	{
+		return;
+	}
+
+	node.checker.verify (check);
+
+	for (std::size_t i = 0; i < entries.size (); ++i)
+	{
+		auto & [ctx, verification] = entries[i];
+		if (check.valid (i))
+		{
+			ctx->verification = verification;
+			node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::signature_verified);
+		}
+		else
+		{
+			// Leave verification to the ledger, which reports the correct status
+			node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::signature_unverified);
+		}
+	}
+}
+
+void nano::block_processor::prefetch (std::deque<context> const & batch)
+{
+	if (!config.prefetch)
+	{
+		return;
+	}
+
+	// Blocks with a conclusive precheck result are not looked up by the ledger
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	blocks.reserve (batch.size ());
+	for (auto const & ctx : batch)
+	{
+		if (!ctx.prechecked)
+		{
+			blocks.push_back (ctx.block);
+		}
+	}
+	if (blocks.empty ())
+	{
+		return;
+	}
+
+	// Reads happen outside of the write transaction, so writers are not held up by cold reads
+	node.ledger.prefetch (node.ledger.tx_begin_read (), blocks);
+	node.stats.add (nano::stat::type::blockprocessor, nano::stat::detail::prefetch, blocks.size ());
+}
+
 void nano::block_processor::queue_unchecked (secure::write_transaction const & transaction_a, nano::hash_or_account const & hash_or_account_a)
 {
 	node.unchecked.trigger (hash_or_account_a);
@@ -458,7 +758,10 @@ std::unique_ptr<nano::container_info_component> nano::block_processor::collect_c
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", queue.size (), 0 }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "forced", queue.size ({ nano::block_source::forced }), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "batch_size", batch_size.size (), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "prepared", prepared ? prepared->size () : 0, 0 }));
 	composite->add_component (queue.collect_container_info ("queue"));
+	composite->add_component (notification_workers.collect_container_info ("notification_workers"));
 	return composite;
 }
 
@@ -487,6 +790,11 @@ nano::error nano::block_processor_config::serialize (nano::tomlconfig & toml) co
 	toml.put ("priority_live", priority_live, "Priority for live network blocks. Higher priority gets processed more frequently. \ntype:uint64");
 	toml.put ("priority_bootstrap", priority_bootstrap, "Priority for bootstrap blocks. Higher priority gets processed more frequently. \ntype:uint64");
 	toml.put ("priority_local", priority_local, "Priority for local RPC blocks. Higher priority gets processed more frequently. \ntype:uint64");
+	toml.put ("batch_target_time", batch_target_time, "Target duration of a single block processing write transaction. Batch size is adjusted between batch_min_size and batch_max_size to stay close to it. \ntype:milliseconds");
+	toml.put ("batch_min_size", batch_min_size, "Minimum number of blocks processed in a single write transaction. \ntype:uint64");
+	toml.put ("batch_max_size", batch_max_size, "Maximum number of blocks processed in a single write transaction. \ntype:uint64");
+	toml.put ("pipeline", pipeline, "Overlap read-only prechecks of the next batch with committing the current batch and notify observers from a separate thread. \ntype:bool");
+	toml.put ("prefetch", prefetch, "Read the ledger entries a batch will look up in sorted order before taking the write transaction, turning scattered reads into ordered ones on cold caches. \ntype:bool");
 
 	return toml.get_error ();
 }
@@ -498,6 +806,11 @@ nano::error nano::block_processor_config::deserialize (nano::tomlconfig & toml)
 	toml.get ("priority_live", priority_live);
 	toml.get ("priority_bootstrap", priority_bootstrap);
 	toml.get ("priority_local", priority_local);
+	toml.get ("batch_target_time", batch_target_time);
+	toml.get ("batch_min_size", batch_min_size);
+	toml.get ("batch_max_size", batch_max_size);
+	toml.get ("pipeline", pipeline);
+	toml.get ("prefetch", prefetch);
 
 	return toml.get_error ();
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <nano/lib/batch_size_controller.hpp>
 #include <nano/lib/logging.hpp>
+#include <nano/lib/thread_pool.hpp>
 #include <nano/node/fair_queue.hpp>
 #include <nano/secure/common.hpp>
 
@@ -9,6 +11,7 @@
 #include <memory>
 #include <optional>
 #include <thread>
+#include <unordered_set>
 
 namespace nano
 {
@@ -18,6 +21,7 @@ class node;
 
 namespace nano::secure
 {
+class transaction;
 class write_transaction;
 }
 
@@ -55,6 +59,16 @@ public:
 	size_t priority_live{ 1 };
 	size_t priority_bootstrap{ 8 };
 	size_t priority_local{ 16 };
+
+	// Target duration of a single write transaction in milliseconds, the batch size adapts to stay close to it
+	nano::millis_t batch_target_time{ 50 };
+	size_t batch_min_size{ 16 };
+	size_t batch_max_size{ 16 * 1024 };
+
+	// Overlap dequeuing and read-only prechecks of the next batch with committing the current one, notify observers from a separate thread
+	bool pipeline{ false };
+	// Read the ledger entries of a batch in sorted order before taking the write transaction
+	bool prefetch{ true };
 };
 
 /**
@@ -72,6 +86,10 @@ public: // Context
 		std::shared_ptr<nano::block> const block;
 		block_source const source;
 		std::chrono::steady_clock::time_point const arrival{ std::chrono::steady_clock::now () };
+		// Set by the signature pre-verification stage, trusted by the ledger when processing
+		nano::signature_verification verification{ nano::signature_verification::unknown };
+		// Set by the read-only precheck stage when the result is known without a write transaction
+		std::optional<nano::block_status> prechecked;
 
 	public:
 		using result_t = nano::block_status;
@@ -118,6 +136,18 @@ private:
 	nano::block_status process_one (secure::write_transaction const &, context const &, bool forced = false);
 	void queue_unchecked (secure::write_transaction const &, nano::hash_or_account const &);
 	processed_batch_t process_batch (nano::unique_lock<nano::mutex> &);
+	processed_batch_t process_prepared (nano::unique_lock<nano::mutex> &);
+	processed_batch_t commit_batch (std::deque<context> &);
+	void update_batch_size (size_t count, std::chrono::microseconds elapsed);
+	void notify_processed (processed_batch_t &&);
+	void run_precheck ();
+	// Resolves `old` and `gap_previous` blocks using a read transaction. Blocks in `exclusions` may not yet be visible to it
+	// and `rollbacks` tells whether the batch being committed may roll back blocks that are still visible to it
+	void precheck (std::deque<context> &, std::unordered_set<nano::block_hash> const & exclusions, bool rollbacks);
+	std::optional<nano::block_status> precheck_one (secure::transaction const &, context const &, std::unordered_set<nano::block_hash> const & exclusions, bool rollbacks);
+	// Batch verifies signatures of blocks whose signer is known without a ledger lookup
+	void verify_signatures (std::deque<context> &);
+	void prefetch (std::deque<context> const &);
 	std::deque<context> next_batch (size_t max_count);
 	context next ();
 	bool add_impl (context, std::shared_ptr<nano::transport::channel> const & channel = nullptr);
@@ -128,6 +158,16 @@ private: // Dependencies
 
 private:
 	nano::fair_queue<context, block_source> queue;
+	nano::batch_size_controller batch_size;
+
+	// Pipelined mode: batch prechecked and waiting for the write transaction
+	std::optional<std::deque<context>> prepared;
+	// Pipelined mode: hashes of the batch currently being committed
+	std::unordered_set<nano::block_hash> in_flight;
+	// Pipelined mode: whether the batch currently being committed contains forced blocks
+	bool in_flight_forced{ false };
+	// Pipelined mode: number of processed batches whose observers have not yet run
+	size_t pending_notifications{ 0 };
 
 	std::chrono::steady_clock::time_point next_log;
 
@@ -135,5 +175,7 @@ private:
 	nano::condition_variable condition;
 	mutable nano::mutex mutex{ mutex_identifier (mutexes::block_processor) };
 	std::thread thread;
+	std::thread precheck_thread;
+	nano::thread_pool notification_workers;
 };
 }
@@ -7,6 +7,7 @@
 #include <nano/node/inactive_node.hpp>
 #include <nano/node/node.hpp>
 #include <nano/secure/ledger.hpp>
+#include <nano/store/version.hpp>
 
 #include <boost/format.hpp>
 
@@ -601,6 +602,8 @@ std::error_code nano::handle_node_options (boost::program_options::variables_map
 						{
 							node.node->store.confirmation_height.clear (transaction, account);
 						}
+						// Cemented count is recounted on next start
+						node.node->store.version.counter_del (transaction, nano::store::counter::cemented_count);
 
 						std::cout << "Confirmation height of account " << account_str << " is set to " << conf_height_reset_num << std::endl;
 					}
@@ -1364,6 +1367,7 @@ void reset_confirmation_heights (nano::store::write_transaction const & transact
 
 	// Then make sure the confirmation height of the genesis account open block is 1
 	store.confirmation_height.put (transaction, constants.genesis->account (), { 1, constants.genesis->hash () });
+	store.version.counter_put (transaction, nano::store::counter::cemented_count, 1);
 }
 
 bool is_using_rocksdb (std::filesystem::path const & data_path, boost::program_options::variables_map const & vm, std::error_code & ec)
@@ -1,14 +1,19 @@
 #include <nano/lib/thread_roles.hpp>
+#include <nano/lib/timer.hpp>
+#include <nano/lib/tomlconfig.hpp>
 #include <nano/node/confirming_set.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_confirmed.hpp>
 #include <nano/store/component.hpp>
 #include <nano/store/write_queue.hpp>
 
-nano::confirming_set::confirming_set (nano::ledger & ledger_a, nano::stats & stats_a) :
+nano::confirming_set::confirming_set (confirming_set_config const & config_a, nano::ledger & ledger_a, nano::stats & stats_a) :
+	config{ config_a },
 	ledger{ ledger_a },
 	stats{ stats_a },
-	notification_workers{ 1, nano::thread_role::name::confirmation_height_notifications }
+	batch_size{ std::chrono::milliseconds{ config.batch_target_time }, config.batch_min_size, config.batch_max_size, 256 },
+	notification_workers{ 1, nano::thread_role::name::confirmation_height_notifications },
+	resolver_workers{ static_cast<unsigned> (std::max<size_t> (config.resolver_threads, 1)), nano::thread_role::name::confirmation_height_resolver }
 {
 	batch_cemented.add ([this] (auto const & notification) {
 		for (auto const & [block, confirmation_root] : notification.cemented)
@@ -70,6 +75,7 @@ void nano::confirming_set::stop ()
 		thread.join ();
 	}
 	notification_workers.stop ();
+	resolver_workers.stop ();
 }
 
 bool nano::confirming_set::exists (nano::block_hash const & hash) const
@@ -128,27 +134,79 @@ void nano::confirming_set::run_batch (std::unique_lock<std::mutex> & lock)
 	std::deque<cemented_t> cemented;
 	std::deque<nano::block_hash> already;
 
-	auto batch = next_batch (256);
+	auto batch = next_batch (batch_size.size ());
 
 	lock.unlock ();
 
+	auto notify = [this, &cemented, &already] () {
+		cemented_notification notification{
+			.cemented = std::move (cemented),
+			.already_cemented = std::move (already)
+		};
+		cemented.clear ();
+		already.clear ();
+
+		notification_workers.push_task ([this, notification = std::move (notification)] () {
+			stats.inc (nano::stat::type::confirming_set, nano::stat::detail::notify);
+			batch_cemented.notify (notification);
+		});
+	};
+
+	std::vector<std::optional<resolution>> resolved;
+	if (config.resolver_threads > 0)
+	{
+		resolved = resolve (batch);
+	}
+
+	// The batch size controls how long the write transaction is held, waiting for the write queue and resolving are not part of it
+	nano::timer<std::chrono::microseconds> timer;
 	{
 		auto transaction = ledger.tx_begin_write ({ nano::tables::confirmation_height }, nano::store::writer::confirmation_height);
+		timer.start ();
 
-		for (auto const & hash : batch)
+		for (std::size_t index = 0; index < batch.size (); ++index)
 		{
+			auto const & hash = batch[index];
 			transaction.refresh_if_needed ();
 
-			auto added = ledger.confirm (transaction, hash);
-			if (!added.empty ())
-			{
+			std::size_t added = 0;
+			auto cement = [&] (std::deque<std::shared_ptr<nano::block>> & blocks) {
 				// Confirming this block may implicitly confirm more
-				for (auto & block : added)
+				for (auto & block : blocks)
 				{
 					cemented.emplace_back (block, hash);
 				}
+				added += blocks.size ();
 
-				stats.add (nano::stat::type::confirming_set, nano::stat::detail::cemented, added.size ());
+				// Commit before notifying so observers see the blocks as cemented
+				if (cemented.size () >= config.cementing_chunk_size)
+				{
+					transaction.refresh ();
+					notify ();
+					stats.inc (nano::stat::type::confirming_set, nano::stat::detail::cemented_chunk);
+				}
+			};
+
+			// Dependencies are only walked again if resolving them did not finish or the account chains changed since
+			bool walk = true;
+			if (index < resolved.size () && resolved[index])
+			{
+				if (!ledger.confirm_resolved (transaction, resolved[index]->blocks, config.cementing_chunk_size, cement))
+				{
+					walk = resolved[index]->partial;
+				}
+				else
+				{
+					stats.inc (nano::stat::type::confirming_set, nano::stat::detail::resolved_stale);
+				}
+			}
+			if (walk)
+			{
+				ledger.confirm (transaction, hash, config.cementing_chunk_size, cement);
+			}
+			if (added > 0)
+			{
+				stats.add (nano::stat::type::confirming_set, nano::stat::detail::cemented, added);
 			}
 			else
 			{
@@ -158,15 +216,99 @@ void nano::confirming_set::run_batch (std::unique_lock<std::mutex> & lock)
 		}
 	}
 
-	cemented_notification notification{
-		.cemented = std::move (cemented),
-		.already_cemented = std::move (already)
+	// The batch size is read by collect_container_info, so it is only modified under the mutex
+	auto const elapsed = timer.stop ();
+	lock.lock ();
+	auto const decision = batch_size.update (batch.size (), elapsed);
+	auto const size = batch_size.size ();
+	lock.unlock ();
+
+	switch (decision)
+	{
+		case nano::batch_size_controller::decision::increase:
+			stats.inc (nano::stat::type::confirming_set, nano::stat::detail::batch_size_increase);
+			break;
+		case nano::batch_size_controller::decision::decrease:
+			stats.inc (nano::stat::type::confirming_set, nano::stat::detail::batch_size_decrease);
+			break;
+		case nano::batch_size_controller::decision::keep:
+			break;
+	}
+	stats.sample (nano::stat::sample::confirming_set_batch_size, size, { config.batch_min_size, config.batch_max_size });
+
+	if (!cemented.empty () || !already.empty ())
+	{
+		notify ();
+	}
+}
+
+auto nano::confirming_set::resolve (std::deque<nano::block_hash> const & batch) -> std::vector<std::optional<resolution>>
+{
+	// Walking dependencies only needs read transactions. Doing it in parallel beforehand leaves the serial pass under
+	// the write transaction with checking the resolved blocks still extend the cemented frontiers and the confirmation height writes.
+	struct state_t
+	{
+		std::deque<nano::block_hash> batch;
+		std::vector<std::optional<resolution>> resolved;
+		// Bounds the number of resolved blocks held until cementing, enough for one block per hash plus one long chain
+		std::atomic<std::size_t> budget{ 0 };
+		std::atomic<std::size_t> next{ 0 };
+		std::size_t done{ 0 };
+		std::mutex mutex;
+		std::condition_variable condition;
 	};
+	auto state = std::make_shared<state_t> ();
+	state->batch = batch;
+	state->resolved.resize (batch.size ());
+	state->budget = batch.size () + config.cementing_chunk_size;
 
-	notification_workers.push_task ([this, notification = std::move (notification)] () {
-		stats.inc (nano::stat::type::confirming_set, nano::stat::detail::notify);
-		batch_cemented.notify (notification);
-	});
+	// Hashes are claimed one at a time by whichever thread is free, so a few long chains don't hold up the rest of the batch.
+	// The calling thread claims hashes too which guarantees progress even if the pool is stopped.
+	auto process = [this, state] () {
+		std::optional<nano::secure::read_transaction> transaction;
+		std::size_t resolved = 0;
+		for (auto index = state->next++; index < state->batch.size (); index = state->next++)
+		{
+			auto available = state->budget.load ();
+			std::size_t claimed;
+			do
+			{
+				claimed = std::min (available, config.cementing_chunk_size);
+			} while (!state->budget.compare_exchange_weak (available, available - claimed));
+
+			// Hashes left without budget are walked under the write transaction
+			if (claimed > 0)
+			{
+				if (!transaction)
+				{
+					transaction.emplace (ledger.tx_begin_read ());
+				}
+				transaction->refresh_if_needed ();
+				auto blocks = ledger.confirm_resolve (*transaction, state->batch[index], claimed);
+				state->budget += claimed - blocks.size ();
+				resolved += blocks.size ();
+				auto const partial = blocks.size () == claimed;
+				state->resolved[index] = resolution{ std::move (blocks), partial };
+			}
+			{
+				std::lock_guard guard{ state->mutex };
+				++state->done;
+			}
+			state->condition.notify_all ();
+		}
+		stats.add (nano::stat::type::confirming_set, nano::stat::detail::resolved, resolved);
+	};
+
+	auto const helpers = std::min<std::size_t> (resolver_workers.get_num_threads (), batch.size () - 1);
+	for (std::size_t i = 0; i < helpers; ++i)
+	{
+		resolver_workers.push_task (process);
+	}
+	process ();
+
+	std::unique_lock lock{ state->mutex };
+	state->condition.wait (lock, [&state] () { return state->done == state->batch.size (); });
+	return std::move (state->resolved);
 }
 
 std::unique_ptr<nano::container_info_component> nano::confirming_set::collect_container_info (std::string const & name) const
@@ -175,6 +317,34 @@ std::unique_ptr<nano::container_info_component> nano::confirming_set::collect_co
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "set", set.size (), sizeof (typename decltype (set)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "batch_size", batch_size.size (), 0 }));
 	composite->add_component (notification_workers.collect_container_info ("notification_workers"));
+	composite->add_component (resolver_workers.collect_container_info ("resolver_workers"));
 	return composite;
 }
+
+/*
+ * confirming_set_config
+ */
+
+nano::error nano::confirming_set_config::serialize (nano::tomlconfig & toml) const
+{
+	toml.put ("batch_target_time", batch_target_time, "Target duration of a single cementing write transaction. Batch size is adjusted between batch_min_size and batch_max_size to stay close to it. \ntype:milliseconds");
+	toml.put ("batch_min_size", batch_min_size, "Minimum number of blocks cemented in a single write transaction. \ntype:uint64");
+	toml.put ("batch_max_size", batch_max_size, "Maximum number of blocks cemented in a single write transaction. \ntype:uint64");
+	toml.put ("resolver_threads", resolver_threads, "Number of threads resolving block dependencies in parallel before a batch is cemented. 0 disables the resolving phase. \ntype:uint64");
+	toml.put ("cementing_chunk_size", cementing_chunk_size, "Maximum number of cemented blocks held in memory before they are committed and notified. Confirming a long chain of uncemented blocks commits the write transaction after each chunk. \ntype:uint64");
+
+	return toml.get_error ();
+}
+
+nano::error nano::confirming_set_config::deserialize (nano::tomlconfig & toml)
+{
+	toml.get ("batch_target_time", batch_target_time);
+	toml.get ("batch_min_size", batch_min_size);
+	toml.get ("batch_max_size", batch_max_size);
+	toml.get ("cementing_chunk_size", cementing_chunk_size);
+	toml.get ("resolver_threads", resolver_threads);
+
+	return toml.get_error ();
+}
@@ -1,14 +1,19 @@
 #pragma once
 
+#include <nano/lib/batch_size_controller.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/observer_set.hpp>
 #include <nano/lib/thread_pool.hpp>
+#include <nano/lib/utility.hpp>
 
+#include <algorithm>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace nano
 {
@@ -16,10 +21,29 @@ class node;
 class block;
 class ledger;
 class stats;
+class tomlconfig;
+class error;
 }
 
 namespace nano
 {
+class confirming_set_config final
+{
+public:
+	nano::error deserialize (nano::tomlconfig & toml);
+	nano::error serialize (nano::tomlconfig & toml) const;
+
+public:
+	// Target duration of a single write transaction in milliseconds, the batch size adapts to stay close to it
+	nano::millis_t batch_target_time{ 50 };
+	size_t batch_min_size{ 16 };
+	size_t batch_max_size{ 16 * 1024 };
+	// Long chains are cemented, committed and notified in chunks of this many blocks to keep memory use bounded
+	size_t cementing_chunk_size{ 4 * 1024 };
+	// Threads walking block dependencies ahead of cementing, 0 disables the resolving phase
+	size_t resolver_threads{ std::clamp (nano::hardware_concurrency () / 2, 1u, 4u) };
+};
+
 /**
  * Set of blocks to be durably confirmed
  */
@@ -29,7 +53,7 @@ class confirming_set final
 	friend class confirmation_height_pruned_source_Test;
 
 public:
-	confirming_set (nano::ledger &, nano::stats &);
+	confirming_set (confirming_set_config const &, nano::ledger &, nano::stats &);
 	~confirming_set ();
 
 	// Adds a block to the set of blocks to be confirmed
@@ -59,14 +83,27 @@ public: // Events
 private:
 	void run ();
 	void run_batch (std::unique_lock<std::mutex> &);
+	// Blocks cementing a hash of the batch is expected to cement, found ahead of taking the write transaction
+	class resolution final
+	{
+	public:
+		std::deque<std::shared_ptr<nano::block>> blocks;
+		// The walk stopped at its limit, cementing has to continue walking past the resolved blocks
+		bool partial{ false };
+	};
+	// Resolves each hash of the batch in parallel, hashes left unresolved are empty
+	std::vector<std::optional<resolution>> resolve (std::deque<nano::block_hash> const &);
 	std::deque<nano::block_hash> next_batch (size_t max_count);
 
+	confirming_set_config const & config;
 	nano::ledger & ledger;
 	nano::stats & stats;
 
 	std::unordered_set<nano::block_hash> set;
+	nano::batch_size_controller batch_size;
 
 	nano::thread_pool notification_workers;
+	nano::thread_pool resolver_workers;
 
 	bool stopped{ false };
 	mutable std::mutex mutex;
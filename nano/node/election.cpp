@@ -31,7 +31,10 @@ nano::election::election (nano::node & node_a, std::shared_ptr<nano::block> cons
 	root (block_a->root ()),
 	qualified_root (block_a->qualified_root ())
 {
-	last_votes.emplace (nano::account::null (), nano::vote_info{ std::chrono::steady_clock::now (), 0, block_a->hash () });
+	nano::vote_info const initial{ std::chrono::steady_clock::now (), 0, block_a->hash () };
+	tally_weights_version = node.ledger.weights_version ();
+	last_votes.emplace (nano::account::null (), initial);
+	tally_add (nano::account::null (), initial, node.ledger.weight (nano::account::null ()));
 	last_blocks.emplace (block_a->hash (), block_a);
 }
 
@@ -231,13 +234,18 @@ void nano::election::broadcast_vote ()
 nano::vote_info nano::election::get_last_vote (nano::account const & account)
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
+	if (auto existing = last_votes.find (account); existing != last_votes.end ())
+	{
+		return existing->second;
+	}
+	set_vote (account, nano::vote_info{}, node.ledger.weight (account));
 	return last_votes[account];
 }
 
 void nano::election::set_last_vote (nano::account const & account, nano::vote_info vote_info)
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	last_votes[account] = vote_info;
+	set_vote (account, vote_info, node.ledger.weight (account));
 }
 
 nano::election_status nano::election::get_status () const
@@ -341,40 +349,113 @@ nano::tally_t nano::election::tally () const
 
 nano::tally_t nano::election::tally_impl () const
 {
-	std::unordered_map<nano::block_hash, nano::uint128_t> block_weights;
-	std::unordered_map<nano::block_hash, nano::uint128_t> final_weights_l;
-	for (auto const & [account, info] : last_votes)
+	debug_assert (!mutex.try_lock ());
+
+	// Weights used for the tally are outdated, start over. Weights change with nearly every processed block,
+	// so changes are picked up at most once per base latency instead of turning every vote into a full recount
+	if (tally_weights_version != node.ledger.weights_version () && std::chrono::steady_clock::now () >= tally_recompute_time + base_latency ())
 	{
-		auto rep_weight (node.ledger.weight (account));
-		block_weights[info.hash] += rep_weight;
-		if (info.timestamp == std::numeric_limits<uint64_t>::max ())
-		{
-			final_weights_l[info.hash] += rep_weight;
-		}
+		tally_recompute ();
 	}
-	last_tally = block_weights;
+
 	nano::tally_t result;
-	for (auto const & [hash, amount] : block_weights)
+	for (auto const & [hash, entry] : last_tally)
 	{
 		auto block (last_blocks.find (hash));
 		if (block != last_blocks.end ())
 		{
-			result.emplace (amount, block->second);
+			result.emplace (entry.weight, block->second);
 		}
 	}
-	// Calculate final votes sum for winner
-	if (!final_weights_l.empty () && !result.empty ())
+	// Final votes sum for winner
+	if (!result.empty ())
 	{
-		auto winner_hash (result.begin ()->second->hash ());
-		auto find_final (final_weights_l.find (winner_hash));
-		if (find_final != final_weights_l.end ())
+		auto find_final (last_tally.find (result.begin ()->second->hash ()));
+		if (find_final != last_tally.end () && find_final->second.final_voters > 0)
 		{
-			final_weight = find_final->second;
+			final_weight = find_final->second.final_weight;
 		}
 	}
 	return result;
 }
 
+void nano::election::tally_recompute () const
+{
+	debug_assert (!mutex.try_lock ());
+
+	node.stats.inc (nano::stat::type::election, nano::stat::detail::tally_recompute);
+
+	// Read the version before the weights, a concurrent weight change causes another recompute next time
+	tally_weights_version = node.ledger.weights_version ();
+	tally_recompute_time = std::chrono::steady_clock::now ();
+	last_tally.clear ();
+	voter_weights.clear ();
+	for (auto const & [account, info] : last_votes)
+	{
+		tally_add (account, info, node.ledger.weight (account));
+	}
+}
+
+void nano::election::tally_add (nano::account const & account, nano::vote_info const & info, nano::uint128_t const & weight) const
+{
+	auto & entry = last_tally[info.hash];
+	entry.weight += weight;
+	++entry.voters;
+	if (info.timestamp == std::numeric_limits<uint64_t>::max ())
+	{
+		entry.final_weight += weight;
+		++entry.final_voters;
+	}
+	voter_weights[account] = weight;
+}
+
+void nano::election::tally_remove (nano::account const & account, nano::vote_info const & info) const
+{
+	auto weight = voter_weights.find (account);
+	auto entry = last_tally.find (info.hash);
+	debug_assert (weight != voter_weights.end () && entry != last_tally.end ());
+	if (weight == voter_weights.end () || entry == last_tally.end ())
+	{
+		return;
+	}
+	entry->second.weight -= weight->second;
+	--entry->second.voters;
+	if (info.timestamp == std::numeric_limits<uint64_t>::max ())
+	{
+		entry->second.final_weight -= weight->second;
+		--entry->second.final_voters;
+	}
+	if (entry->second.voters == 0)
+	{
+		last_tally.erase (entry);
+	}
+	voter_weights.erase (weight);
+}
+
+void nano::election::set_vote (nano::account const & account, nano::vote_info const & info, nano::uint128_t const & weight)
+{
+	debug_assert (!mutex.try_lock ());
+
+	if (auto existing = last_votes.find (account); existing != last_votes.end ())
+	{
+		tally_remove (account, existing->second);
+		existing->second = info;
+	}
+	else
+	{
+		last_votes.emplace (account, info);
+	}
+	tally_add (account, info, weight);
+}
+
+auto nano::election::erase_vote (std::unordered_map<nano::account, nano::vote_info>::iterator existing) -> std::unordered_map<nano::account, nano::vote_info>::iterator
+{
+	debug_assert (!mutex.try_lock ());
+
+	tally_remove (existing->first, existing->second);
+	return last_votes.erase (existing);
+}
+
 void nano::election::confirm_if_quorum (nano::unique_lock<nano::mutex> & lock_a)
 {
 	debug_assert (lock_a.owns_lock ());
@@ -472,7 +553,7 @@ nano::vote_code nano::election::vote (nano::account const & rep, uint64_t timest
 		}
 	}
 
-	last_votes[rep] = { std::chrono::steady_clock::now (), timestamp_a, block_hash_a };
+	set_vote (rep, { std::chrono::steady_clock::now (), timestamp_a, block_hash_a }, weight);
 	if (vote_source_a != vote_source::cache)
 	{
 		live_vote_action (rep);
@@ -617,7 +698,10 @@ void nano::election::remove_votes (nano::block_hash const & hash_a)
 		auto list_generated_votes (node.history.votes (root, hash_a));
 		for (auto const & vote : list_generated_votes)
 		{
-			last_votes.erase (vote->account);
+			if (auto existing = last_votes.find (vote->account); existing != last_votes.end ())
+			{
+				erase_vote (existing);
+			}
 		}
 		// Clear votes cache
 		node.history.erase (root);
@@ -631,9 +715,10 @@ void nano::election::remove_block (nano::block_hash const & hash_a)
 	{
 		if (auto existing = last_blocks.find (hash_a); existing != last_blocks.end ())
 		{
-			erase_if (last_votes, [hash_a] (auto const & entry) {
-				return entry.second.hash == hash_a;
-			});
+			for (auto it = last_votes.begin (); it != last_votes.end ();)
+			{
+				it = it->second.hash == hash_a ? erase_vote (it) : std::next (it);
+			}
 
 			node.network.publish_filter.clear (existing->second);
 			last_blocks.erase (hash_a);
@@ -649,7 +734,10 @@ bool nano::election::replace_by_weight (nano::unique_lock<nano::mutex> & lock_a,
 	// Sort existing blocks tally
 	std::vector<std::pair<nano::block_hash, nano::uint128_t>> sorted;
 	sorted.reserve (last_tally.size ());
-	std::copy (last_tally.begin (), last_tally.end (), std::back_inserter (sorted));
+	for (auto const & [hash, entry] : last_tally)
+	{
+		sorted.emplace_back (hash, entry.weight);
+	}
 	lock_a.unlock ();
 
 	// Sort in ascending order
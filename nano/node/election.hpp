@@ -140,6 +140,14 @@ public: // Information
 
 private:
 	nano::tally_t tally_impl () const;
+	// Replaces the vote of a representative, keeping the tally up to date
+	void set_vote (nano::account const &, nano::vote_info const &, nano::uint128_t const & weight);
+	// Returns the iterator following the erased vote
+	std::unordered_map<nano::account, nano::vote_info>::iterator erase_vote (std::unordered_map<nano::account, nano::vote_info>::iterator);
+	void tally_add (nano::account const &, nano::vote_info const &, nano::uint128_t const & weight) const;
+	void tally_remove (nano::account const &, nano::vote_info const &) const;
+	// Rebuilds the tally from scratch using current representative weights
+	void tally_recompute () const;
 	bool confirmed_locked () const;
 	nano::election_extended_status current_status_locked () const;
 	// lock_a does not own the mutex on return
@@ -170,7 +178,21 @@ private:
 	std::unordered_map<nano::account, nano::vote_info> last_votes;
 	std::atomic<bool> is_quorum{ false };
 	mutable nano::uint128_t final_weight{ 0 };
-	mutable std::unordered_map<nano::block_hash, nano::uint128_t> last_tally;
+
+	class tally_entry final
+	{
+	public:
+		nano::uint128_t weight{ 0 };
+		nano::uint128_t final_weight{ 0 };
+		size_t voters{ 0 };
+		size_t final_voters{ 0 };
+	};
+	// Vote weight per block, updated incrementally as votes change. Rebuilt at most once per base latency when representative weights change
+	mutable std::unordered_map<nano::block_hash, tally_entry> last_tally;
+	// Weight each representative contributes to the tally
+	mutable std::unordered_map<nano::account, nano::uint128_t> voter_weights;
+	mutable uint64_t tally_weights_version{ 0 };
+	mutable std::chrono::steady_clock::time_point tally_recompute_time{};
 
 	nano::election_behavior const behavior_m;
 	std::chrono::steady_clock::time_point const election_start{ std::chrono::steady_clock::now () };
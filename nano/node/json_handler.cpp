@@ -2263,19 +2263,25 @@ void nano::json_handler::delegators ()
 	{
 		auto transaction (node.ledger.tx_begin_read ());
 		boost::property_tree::ptree delegators;
-		for (auto i (node.ledger.any.account_upper_bound (transaction, start_account)), n (node.ledger.any.account_end ()); i != n && delegators.size () < count; ++i)
+		// Scanning starts after `start`, there is nothing after the largest account
+		if (start_account.number () != std::numeric_limits<nano::uint256_t>::max ())
 		{
-			nano::account_info const & info (i->second);
-			if (info.representative == representative)
-			{
-				if (info.balance.number () >= threshold.number ())
+			node.ledger.any.account_for_each_range (transaction, start_account.number () + 1, 0, [&] (nano::account const & delegator, nano::account_info const & info) {
+				if (delegators.size () >= count)
 				{
-					std::string balance;
-					nano::uint128_union (info.balance).encode_dec (balance);
-					nano::account const & delegator (i->first);
-					delegators.put (delegator.to_account (), balance);
+					return false;
 				}
-			}
+				if (info.representative == representative)
+				{
+					if (info.balance.number () >= threshold.number ())
+					{
+						std::string balance;
+						nano::uint128_union (info.balance).encode_dec (balance);
+						delegators.put (delegator.to_account (), balance);
+					}
+				}
+				return true;
+			});
 		}
 		response_l.add_child ("delegators", delegators);
 	}
@@ -2289,14 +2295,13 @@ void nano::json_handler::delegators_count ()
 	{
 		uint64_t count (0);
 		auto transaction (node.ledger.tx_begin_read ());
-		for (auto i (node.ledger.any.account_begin (transaction)), n (node.ledger.any.account_end ()); i != n; ++i)
-		{
-			nano::account_info const & info (i->second);
+		node.ledger.any.account_for_each_range (transaction, 0, 0, [&] (nano::account const &, nano::account_info const & info) {
 			if (info.representative == account)
 			{
 				++count;
 			}
-		}
+			return true;
+		});
 		response_l.put ("count", std::to_string (count));
 	}
 	response_errors ();
@@ -2801,19 +2806,20 @@ void nano::json_handler::ledger ()
 		auto transaction = node.ledger.tx_begin_read ();
 		if (!ec && !sorting) // Simple
 		{
-			for (auto i (node.ledger.any.account_lower_bound (transaction, start)), n (node.ledger.any.account_end ()); i != n && accounts.size () < count; ++i)
-			{
-				nano::account_info const & info (i->second);
+			node.ledger.any.account_for_each_range (transaction, start, 0, [&] (nano::account const & account, nano::account_info const & info) {
+				if (accounts.size () >= count)
+				{
+					return false;
+				}
 				if (info.modified >= modified_since && (receivable || info.balance.number () >= threshold.number ()))
 				{
-					nano::account const & account (i->first);
 					boost::property_tree::ptree response_a;
 					if (receivable)
 					{
 						auto account_receivable = node.ledger.account_receivable (transaction, account);
 						if (info.balance.number () + account_receivable < threshold.number ())
 						{
-							continue;
+							return true;
 						}
 						response_a.put ("pending", account_receivable.convert_to<std::string> ());
 						response_a.put ("receivable", account_receivable.convert_to<std::string> ());
@@ -2837,20 +2843,20 @@ void nano::json_handler::ledger ()
 					}
 					accounts.push_back (std::make_pair (account.to_account (), response_a));
 				}
-			}
+				return true;
+			});
 		}
 		else if (!ec) // Sorting
 		{
 			std::vector<std::pair<nano::uint128_union, nano::account>> ledger_l;
-			for (auto i (node.ledger.any.account_lower_bound (transaction, start)), n (node.ledger.any.account_end ()); i != n; ++i)
-			{
-				nano::account_info const & info (i->second);
+			node.ledger.any.account_for_each_range (transaction, start, 0, [&ledger_l, modified_since] (nano::account const & account, nano::account_info const & info) {
 				nano::uint128_union balance (info.balance);
 				if (info.modified >= modified_since)
 				{
-					ledger_l.emplace_back (balance, i->first);
+					ledger_l.emplace_back (balance, account);
 				}
-			}
+				return true;
+			});
 			std::sort (ledger_l.begin (), ledger_l.end ());
 			std::reverse (ledger_l.begin (), ledger_l.end ());
 			nano::account_info info;
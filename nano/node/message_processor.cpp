@@ -15,6 +15,16 @@ nano::message_processor::message_processor (message_processor_config const & con
 	queue.priority_query = [this] (auto const & origin) {
 		return 1;
 	};
+
+	if (config.staging)
+	{
+		// One slot per I/O thread, so producers rarely share a cache line
+		auto const slots = std::max (1u, node.config.io_threads + node.config.io_shards);
+		for (auto i = 0u; i < slots; ++i)
+		{
+			staging.push_back (std::make_unique<staging_slot> ());
+		}
+	}
 }
 
 nano::message_processor::~message_processor ()
@@ -74,6 +84,14 @@ void nano::message_processor::stop ()
 		}
 	}
 	threads.clear ();
+
+	// Drop anything still staged, entries keep their channels alive
+	std::vector<entry_t> leftover;
+	for (auto const & slot : staging)
+	{
+		slot->entries.pop_all (leftover);
+	}
+	staged = 0;
 }
 
 bool nano::message_processor::put (std::unique_ptr<nano::message> message, std::shared_ptr<nano::transport::channel> const & channel)
@@ -81,6 +99,15 @@ bool nano::message_processor::put (std::unique_ptr<nano::message> message, std::
 	release_assert (message != nullptr);
 	release_assert (channel != nullptr);
 
+	if (!staging.empty ())
+	{
+		return put_staging (std::move (message), channel);
+	}
+	return put_queue (std::move (message), channel);
+}
+
+bool nano::message_processor::put_queue (std::unique_ptr<nano::message> message, std::shared_ptr<nano::transport::channel> const & channel)
+{
 	auto const type = message->type ();
 
 	bool added = false;
@@ -88,19 +115,63 @@ bool nano::message_processor::put (std::unique_ptr<nano::message> message, std::
 		nano::lock_guard<nano::mutex> guard{ mutex };
 		added = queue.push ({ std::move (message), channel }, { nano::no_value{}, channel });
 	}
+	count (type, added);
 	if (added)
 	{
-		stats.inc (nano::stat::type::message_processor, nano::stat::detail::process);
-		stats.inc (nano::stat::type::message_processor_type, to_stat_detail (type));
+		condition.notify_all ();
+	}
+	return added;
+}
+
+namespace
+{
+std::size_t staging_thread_index ()
+{
+	static std::atomic<std::size_t> next{ 0 };
+	thread_local std::size_t const index = next++;
+	return index;
+}
+}
 
+bool nano::message_processor::put_staging (std::unique_ptr<nano::message> message, std::shared_ptr<nano::transport::channel> const & channel)
+{
+	debug_assert (!staging.empty ());
+
+	// Approximate bound, concurrent producers may overshoot it slightly. Staging is shared by all peers, so when it is full messages
+	// go straight to the processing queue where per peer limits decide what is dropped, instead of a flooding peer crowding out the others
+	if (staged.load (std::memory_order_relaxed) >= static_cast<int64_t> (config.max_staging))
+	{
+		stats.inc (nano::stat::type::message_processor, nano::stat::detail::staging_overfill);
+		return put_queue (std::move (message), channel);
+	}
+
+	auto & slot = *staging[staging_thread_index () % staging.size ()];
+	slot.entries.push ({ std::move (message), channel });
+	stats.inc (nano::stat::type::message_processor, nano::stat::detail::staging);
+
+	// Only the producer ending an idle period wakes the processing threads. Taking the mutex orders the wakeup after a processing thread that is about to wait has checked `staged`
+	if (staged++ == 0)
+	{
+		{
+			nano::lock_guard<nano::mutex> guard{ mutex };
+		}
 		condition.notify_all ();
 	}
+	return true;
+}
+
+void nano::message_processor::count (nano::message_type type, bool added)
+{
+	if (added)
+	{
+		stats.inc (nano::stat::type::message_processor, nano::stat::detail::process);
+		stats.inc (nano::stat::type::message_processor_type, to_stat_detail (type));
+	}
 	else
 	{
 		stats.inc (nano::stat::type::message_processor, nano::stat::detail::overfill);
 		stats.inc (nano::stat::type::message_processor_overfill, to_stat_detail (type));
 	}
-	return added;
 }
 
 void nano::message_processor::run ()
@@ -110,6 +181,12 @@ void nano::message_processor::run ()
 	{
 		stats.inc (nano::stat::type::message_processor, nano::stat::detail::loop);
 
+		if (staged > 0)
+		{
+			run_staging (lock);
+			debug_assert (lock.owns_lock ());
+		}
+
 		if (!queue.empty ())
 		{
 			run_batch (lock);
@@ -119,7 +196,7 @@ void nano::message_processor::run ()
 		else
 		{
 			condition.wait (lock, [&] {
-				return stopped || !queue.empty ();
+				return stopped || !queue.empty () || staged > 0;
 			});
 		}
 	}
@@ -155,6 +232,39 @@ void nano::message_processor::run_batch (nano::unique_lock<nano::mutex> & lock)
 	}
 }
 
+void nano::message_processor::run_staging (nano::unique_lock<nano::mutex> & lock)
+{
+	debug_assert (lock.owns_lock ());
+	lock.unlock ();
+
+	std::vector<entry_t> batch;
+	for (auto const & slot : staging)
+	{
+		slot->entries.pop_all (batch);
+	}
+	staged -= batch.size ();
+	stats.sample (nano::stat::sample::message_processor_staging_depth, batch.size (), { 0, config.max_staging });
+
+	std::vector<std::pair<nano::message_type, bool>> results;
+	results.reserve (batch.size ());
+
+	lock.lock ();
+	for (auto & entry : batch)
+	{
+		auto const type = entry.first->type ();
+		auto channel = entry.second;
+		results.emplace_back (type, queue.push (std::move (entry), { nano::no_value{}, std::move (channel) }));
+	}
+	lock.unlock ();
+
+	for (auto const & [type, added] : results)
+	{
+		count (type, added);
+	}
+
+	lock.lock ();
+}
+
 namespace
 {
 // TODO: This was moved, so compare with latest develop before merging to avoid merge bugs
@@ -209,7 +319,12 @@ public:
 	{
 		if (!message.vote->account.is_zero ())
 		{
-			node.vote_processor.vote (message.vote, channel, message.is_rebroadcasted () ? nano::vote_source::rebroadcast : nano::vote_source::live);
+			bool added = node.vote_processor.vote (message.vote, channel, message.is_rebroadcasted () ? nano::vote_source::rebroadcast : nano::vote_source::live);
+			if (!added)
+			{
+				// Let a later copy of the vote through once there is room again
+				node.network.vote_filter.clear (message.digest);
+			}
 		}
 	}
 
@@ -292,6 +407,7 @@ std::unique_ptr<nano::container_info_component> nano::message_processor::collect
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (queue.collect_container_info ("queue"));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "staging", static_cast<std::size_t> (std::max<int64_t> (0, staged)), sizeof (entry_t) }));
 	return composite;
 }
 
@@ -303,6 +419,8 @@ nano::error nano::message_processor_config::serialize (nano::tomlconfig & toml)
 {
 	toml.put ("threads", threads, "Number of threads to use for message processing. \ntype:uint64");
 	toml.put ("max_queue", max_queue, "Maximum number of messages per peer to queue for processing. \ntype:uint64");
+	toml.put ("staging", staging, "Hand messages from network threads over through lock-free staging queues instead of locking the processing queue for each message. \ntype:bool");
+	toml.put ("max_staging", max_staging, "Maximum number of messages staged ahead of the processing queue, across all network threads. Further messages are pushed to the processing queue directly. \ntype:uint64");
 
 	return toml.get_error ();
 }
@@ -311,6 +429,8 @@ nano::error nano::message_processor_config::deserialize (nano::tomlconfig & toml
 {
 	toml.get ("threads", threads);
 	toml.get ("max_queue", max_queue);
+	toml.get ("staging", staging);
+	toml.get ("max_staging", max_staging);
 
 	return toml.get_error ();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/lib/locks.hpp>
+#include <nano/lib/mpsc_queue.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/node/fair_queue.hpp>
 #include <nano/node/fwd.hpp>
@@ -19,10 +20,14 @@ public:
 public:
 	size_t threads{ std::clamp (nano::hardware_concurrency () / 4, 1u, 2u) };
 	size_t max_queue{ 64 };
+	/** Network threads hand messages over through lock-free staging queues instead of taking the processor mutex */
+	bool staging{ true };
+	size_t max_staging{ 1024 * 16 };
 };
 
 /*
- * If mutex locking is ever a performance bottleneck, using a lock-free queue in front of the priority queue should be considered.
+ * Messages from network threads are staged in lock-free queues, one per producing thread slot, and moved into the fair queue in batches by the processing threads.
+ * Network threads only touch the processor mutex when the staging queues go from empty to non-empty, to wake a processing thread.
  */
 class message_processor final
 {
@@ -41,6 +46,10 @@ public:
 private:
 	void run ();
 	void run_batch (nano::unique_lock<nano::mutex> &);
+	void run_staging (nano::unique_lock<nano::mutex> &);
+	bool put_staging (std::unique_ptr<nano::message>, std::shared_ptr<nano::transport::channel> const &);
+	bool put_queue (std::unique_ptr<nano::message>, std::shared_ptr<nano::transport::channel> const &);
+	void count (nano::message_type, bool added);
 
 private: // Dependencies
 	message_processor_config const & config;
@@ -52,6 +61,14 @@ private:
 	using entry_t = std::pair<std::unique_ptr<nano::message>, std::shared_ptr<nano::transport::channel>>;
 	nano::fair_queue<entry_t, nano::no_value> queue;
 
+	struct alignas (64) staging_slot
+	{
+		nano::mpsc_queue<entry_t> entries;
+	};
+	std::vector<std::unique_ptr<staging_slot>> staging;
+	/** Number of staged messages. Signed, it can briefly go negative when a message is taken before its producer has counted it */
+	std::atomic<int64_t> staged{ 0 };
+
 	std::atomic<bool> stopped{ false };
 	nano::mutex mutex;
 	nano::condition_variable condition;
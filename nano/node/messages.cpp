@@ -1,4 +1,5 @@
 #include <nano/lib/blocks.hpp>
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/lib/config.hpp>
 #include <nano/lib/enum_util.hpp>
 #include <nano/lib/memory.hpp>
@@ -326,7 +327,9 @@ nano::message::message (nano::message_header const & header_a) :
 
 std::shared_ptr<std::vector<uint8_t>> nano::message::to_bytes () const
 {
-	auto bytes = std::make_shared<std::vector<uint8_t>> ();
+	// Size the buffer up front so the stream never reallocates out of its pooled storage
+	auto const size_hint = nano::message_header::size + (header.is_valid_message_type () ? header.payload_length_bytes () : 0);
+	auto bytes = nano::buffer_pool::instance ().acquire (size_hint);
 	nano::vectorstream stream (*bytes);
 	serialize (stream);
 	return bytes;
@@ -1856,13 +1859,14 @@ void nano::asc_pull_ack::operator() (nano::object_stream & obs) const
 
 void nano::asc_pull_ack::blocks_payload::serialize (nano::stream & stream) const
 {
-	debug_assert (blocks.size () <= max_blocks);
+	debug_assert (size () <= max_blocks);
 
 	for (auto & block : blocks)
 	{
 		debug_assert (block != nullptr);
 		nano::serialize_block (stream, *block);
 	}
+	nano::write (stream, serialized);
 	// For convenience, end with null block terminator
 	nano::serialize_block_type (stream, nano::block_type::not_a_block);
 }
@@ -1877,9 +1881,15 @@ void nano::asc_pull_ack::blocks_payload::deserialize (nano::stream & stream)
 	}
 }
 
+std::size_t nano::asc_pull_ack::blocks_payload::size () const
+{
+	return blocks.size () + serialized_count;
+}
+
 void nano::asc_pull_ack::blocks_payload::operator() (nano::object_stream & obs) const
 {
 	obs.write_range ("blocks", blocks);
+	obs.write ("serialized_count", serialized_count);
 }
 
 /*
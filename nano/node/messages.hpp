@@ -274,6 +274,8 @@ private:
 
 public: // Payload
 	std::shared_ptr<nano::vote> vote;
+	/** Vote filter digest of the payload, set when received from the network */
+	nano::uint128_t digest{ 0 };
 
 public: // Logging
 	void operator() (nano::object_stream &) const override;
@@ -673,8 +675,17 @@ public: // Payload definitions
 		void serialize (nano::stream &) const;
 		void deserialize (nano::stream &);
 
+		/** Total number of blocks, decoded and serialized */
+		std::size_t size () const;
+
 	public: // Payload
 		std::vector<std::shared_ptr<nano::block>> blocks;
+		/**
+		 * Blocks already in network serialization, written after `blocks`.
+		 * Lets servers copy blocks straight from the store without decoding them. Always empty after deserialization.
+		 */
+		std::vector<uint8_t> serialized;
+		std::size_t serialized_count{ 0 };
 
 	public: // Logging
 		void operator() (nano::object_stream &) const;
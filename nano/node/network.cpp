@@ -1,6 +1,5 @@
 #include "message_processor.hpp"
 
-#include <nano/crypto_lib/random_pool_shuffle.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/lib/utility.hpp>
@@ -24,6 +23,7 @@ nano::network::network (nano::node & node, uint16_t port) :
 	syn_cookies{ node.config.network.max_peers_per_ip, node.logger },
 	resolver{ node.io_ctx },
 	publish_filter{ 256 * 1024 },
+	vote_filter{ 256 * 1024 },
 	tcp_channels{ node },
 	port{ port }
 {
@@ -227,9 +227,11 @@ void nano::network::send_keepalive_self (std::shared_ptr<nano::transport::channe
 
 void nano::network::flood_message (nano::message & message_a, nano::transport::buffer_drop_policy const drop_policy_a, float const scale_a)
 {
+	// Serialize once, every channel shares the same buffer
+	auto const buffer = message_a.to_shared_const_buffer ();
 	for (auto & i : list (fanout (scale_a)))
 	{
-		i->send (message_a, nullptr, drop_policy_a);
+		i->send (message_a, buffer, nullptr, drop_policy_a);
 	}
 }
 
@@ -256,31 +258,34 @@ void nano::network::flood_block (std::shared_ptr<nano::block> const & block_a, n
 void nano::network::flood_block_initial (std::shared_ptr<nano::block> const & block_a)
 {
 	nano::publish message (node.network_params.network, block_a);
+	auto const buffer = message.to_shared_const_buffer ();
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		i.channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
 	}
 	for (auto & i : list_non_pr (fanout (1.0)))
 	{
-		i->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		i->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
 	}
 }
 
 void nano::network::flood_vote (std::shared_ptr<nano::vote> const & vote, float scale, bool rebroadcasted)
 {
 	nano::confirm_ack message{ node.network_params.network, vote, rebroadcasted };
+	auto const buffer = message.to_shared_const_buffer ();
 	for (auto & i : list (fanout (scale)))
 	{
-		i->send (message, nullptr);
+		i->send (message, buffer, nullptr);
 	}
 }
 
 void nano::network::flood_vote_pr (std::shared_ptr<nano::vote> const & vote, bool rebroadcasted)
 {
 	nano::confirm_ack message{ node.network_params.network, vote, rebroadcasted };
+	auto const buffer = message.to_shared_const_buffer ();
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		i.channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
 	}
 }
 
@@ -365,30 +370,48 @@ bool nano::network::track_reachout (nano::endpoint const & endpoint_a)
 
 std::deque<std::shared_ptr<nano::transport::channel>> nano::network::list (std::size_t count_a, uint8_t minimum_version_a, bool include_tcp_temporary_channels_a)
 {
-	std::deque<std::shared_ptr<nano::transport::channel>> result;
-	tcp_channels.list (result, minimum_version_a, include_tcp_temporary_channels_a);
-	nano::random_pool_shuffle (result.begin (), result.end ());
-	if (count_a > 0 && result.size () > count_a)
-	{
-		result.resize (count_a, nullptr);
-	}
-	return result;
+	return tcp_channels.sample (count_a, minimum_version_a);
 }
 
 std::deque<std::shared_ptr<nano::transport::channel>> nano::network::list_non_pr (std::size_t count_a)
 {
+	thread_local nano::random_generator rng;
+
+	auto const split = non_pr_channels ();
 	std::deque<std::shared_ptr<nano::transport::channel>> result;
-	tcp_channels.list (result);
-	nano::random_pool_shuffle (result.begin (), result.end ());
-	result.erase (std::remove_if (result.begin (), result.end (), [this] (std::shared_ptr<nano::transport::channel> const & channel) {
-		return node.rep_crawler.is_pr (channel);
-	}),
-	result.end ());
-	if (result.size () > count_a)
+	nano::random_sample (
+	split->channels, count_a, rng,
+	[] (auto const & channel) { return channel->alive (); },
+	[&result] (auto const & channel) { result.push_back (channel); });
+	return result;
+}
+
+auto nano::network::non_pr_channels () -> std::shared_ptr<non_pr_split const>
+{
+	auto const snapshot = tcp_channels.snapshot ();
+	auto const reps_generation = node.rep_crawler.generation ();
 	{
-		result.resize (count_a, nullptr);
+		nano::lock_guard<nano::mutex> guard{ non_pr_mutex };
+		if (non_pr_cache && non_pr_cache->source == snapshot && non_pr_cache->reps_generation == reps_generation)
+		{
+			return non_pr_cache;
+		}
 	}
-	return result;
+
+	auto split = std::make_shared<non_pr_split> ();
+	split->source = snapshot;
+	split->reps_generation = reps_generation;
+	for (auto const & channel : snapshot->channels)
+	{
+		if (!node.rep_crawler.is_pr (channel))
+		{
+			split->channels.push_back (channel);
+		}
+	}
+
+	nano::lock_guard<nano::mutex> guard{ non_pr_mutex };
+	non_pr_cache = split;
+	return split;
 }
 
 // Simulating with sqrt_broadcast_simulate shows we only need to broadcast to sqrt(total_peers) random peers in order to successfully publish to everyone with high probability
@@ -134,6 +134,16 @@ public: // Handshake
 	nano::node_id_handshake::response_payload prepare_handshake_response (nano::node_id_handshake::query_payload const & query, bool v2) const;
 
 private:
+	/** Channels of a snapshot which are not principal representatives, rebuilt when either the snapshot or the representative set changes */
+	class non_pr_split final
+	{
+	public:
+		std::shared_ptr<nano::transport::tcp_channels::snapshot_t const> source;
+		uint64_t reps_generation;
+		std::vector<std::shared_ptr<nano::transport::channel>> channels;
+	};
+	std::shared_ptr<non_pr_split const> non_pr_channels ();
+
 	void run_cleanup ();
 	void run_keepalive ();
 	void run_reachout ();
@@ -149,6 +159,8 @@ public:
 	boost::asio::ip::tcp::resolver resolver;
 	nano::peer_exclusion excluded_peers;
 	nano::network_filter publish_filter;
+	/** Drops rebroadcasted copies of votes that were already received, before they reach signature verification */
+	nano::network_filter vote_filter;
 	nano::transport::tcp_channels tcp_channels;
 	std::atomic<uint16_t> port{ 0 };
 
@@ -166,6 +178,9 @@ private:
 	std::thread reachout_thread;
 	std::thread reachout_cached_thread;
 
+	nano::mutex non_pr_mutex;
+	std::shared_ptr<non_pr_split const> non_pr_cache;
+
 public:
 	static unsigned const broadcast_interval_ms = 10;
 	static std::size_t const buffer_size = 512;
@@ -1,4 +1,5 @@
 #include <nano/lib/blocks.hpp>
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/lib/stream.hpp>
 #include <nano/lib/thread_runner.hpp>
 #include <nano/lib/tomlconfig.hpp>
@@ -20,7 +21,9 @@
 #include <nano/node/scheduler/manual.hpp>
 #include <nano/node/scheduler/optimistic.hpp>
 #include <nano/node/scheduler/priority.hpp>
+#include <nano/node/signatures.hpp>
 #include <nano/node/telemetry.hpp>
+#include <nano/node/transport/io_shards.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/vote_generator.hpp>
 #include <nano/node/vote_processor.hpp>
@@ -148,6 +151,8 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	logger{ make_logger_identifier (node_id) },
 	runner_impl{ std::make_unique<nano::thread_runner> (io_ctx_shared, logger, config.io_threads) },
 	runner{ *runner_impl },
+	io_shards_impl{ std::make_unique<nano::transport::io_shards> (config.io_shards, logger) },
+	io_shards{ *io_shards_impl },
 	node_initialized_latch (1),
 	network_params{ config.network_params },
 	stats{ logger, config.stats_config },
@@ -163,7 +168,7 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	unchecked{ config.max_unchecked_blocks, stats, flags.disable_block_processor_unchecked_deletion },
 	wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_config)),
 	wallets_store (*wallets_store_impl),
-	ledger_impl{ std::make_unique<nano::ledger> (store, stats, network_params.ledger, flags_a.generate_cache, config_a.representative_vote_weight_minimum.number ()) },
+	ledger_impl{ std::make_unique<nano::ledger> (store, stats, network_params.ledger, flags_a.generate_cache, config_a.representative_vote_weight_minimum.number (), config_a.block_cache_size) },
 	ledger{ *ledger_impl },
 	outbound_limiter{ outbound_bandwidth_limiter_config (config) },
 	message_processor_impl{ std::make_unique<nano::message_processor> (config.message_processor, *this) },
@@ -186,8 +191,10 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	tcp_listener{ *tcp_listener_impl },
 	application_path (application_path_a),
 	port_mapping (*this),
+	checker_impl{ std::make_unique<nano::signature_checker> (config.signature_checker_threads) },
+	checker{ *checker_impl },
 	block_processor (*this),
-	confirming_set_impl{ std::make_unique<nano::confirming_set> (ledger, stats) },
+	confirming_set_impl{ std::make_unique<nano::confirming_set> (config.confirming_set, ledger, stats) },
 	confirming_set{ *confirming_set_impl },
 	active_impl{ std::make_unique<nano::active_elections> (*this, confirming_set, block_processor) },
 	active{ *active_impl },
@@ -201,7 +208,7 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	vote_cache{ config.vote_cache, stats },
 	vote_router_impl{ std::make_unique<nano::vote_router> (vote_cache, active.recently_confirmed) },
 	vote_router{ *vote_router_impl },
-	vote_processor_impl{ std::make_unique<nano::vote_processor> (config.vote_processor, vote_router, observers, stats, flags, logger, online_reps, rep_crawler, ledger, network_params, rep_tiers) },
+	vote_processor_impl{ std::make_unique<nano::vote_processor> (config.vote_processor, vote_router, observers, stats, flags, logger, online_reps, rep_crawler, ledger, network_params, rep_tiers, checker) },
 	vote_processor{ *vote_processor_impl },
 	vote_cache_processor_impl{ std::make_unique<nano::vote_cache_processor> (config.vote_processor, vote_router, vote_cache, stats, logger) },
 	vote_cache_processor{ *vote_cache_processor_impl },
@@ -398,7 +405,7 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 
 		if (!is_initialized && !flags.read_only)
 		{
-			auto const transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::confirmation_height, tables::rep_weights }));
+			auto const transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::confirmation_height, tables::meta, tables::rep_weights }));
 			// Store was empty meaning we just created it, add the genesis block
 			store.initialize (transaction, ledger.cache, ledger.constants);
 		}
@@ -585,6 +592,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (node.vote_cache_processor.collect_container_info ("vote_cache_processor"));
 	composite->add_component (node.rep_crawler.collect_container_info ("rep_crawler"));
 	composite->add_component (node.block_processor.collect_container_info ("block_processor"));
+	composite->add_component (node.checker.collect_container_info ("signature_checker"));
 	composite->add_component (collect_container_info (node.online_reps, "online_reps"));
 	composite->add_component (node.history.collect_container_info ("history"));
 	composite->add_component (node.block_uniquer.collect_container_info ("block_uniquer"));
@@ -602,6 +610,8 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (node.local_block_broadcaster.collect_container_info ("local_block_broadcaster"));
 	composite->add_component (node.rep_tiers.collect_container_info ("rep_tiers"));
 	composite->add_component (node.message_processor.collect_container_info ("message_processor"));
+	composite->add_component (nano::buffer_pool::instance ().collect_container_info ("buffer_pool"));
+	composite->add_component (node.io_shards.collect_container_info ("io_shards"));
 	return composite;
 }
 
@@ -651,6 +661,17 @@ void nano::node::start ()
 			this_l->ongoing_ledger_pruning ();
 		});
 	}
+	if (!flags.read_only)
+	{
+		// Persisted ledger counters are trusted at startup, recount them in the background to catch any drift
+		auto this_l (shared ());
+		workers.push_task ([this_l] () {
+			if (this_l->ledger.verify_counts ([&this_l] () { return this_l->stopped.load (); }))
+			{
+				this_l->logger.warn (nano::log::type::node, "Persisted ledger counters were out of sync and have been corrected");
+			}
+		});
+	}
 	if (!flags.disable_rep_crawler)
 	{
 		rep_crawler.start ();
@@ -752,6 +773,7 @@ void nano::node::stop ()
 	aggregator.stop ();
 	vote_cache_processor.stop ();
 	vote_processor.stop ();
+	checker.stop ();
 	rep_tiers.stop ();
 	scheduler.stop ();
 	active.stop ();
@@ -773,7 +795,8 @@ void nano::node::stop ()
 
 	// work pool is not stopped on purpose due to testing setup
 
-	// Stop the IO runner last
+	// Stop the IO runners last
+	io_shards.stop ();
 	runner.join ();
 	debug_assert (io_ctx_shared.use_count () == 1); // Node should be the last user of the io_context
 }
@@ -967,11 +990,9 @@ bool nano::node::collect_ledger_pruning_targets (std::deque<nano::block_hash> &
 	uint64_t read_operations (0);
 	bool finish_transaction (false);
 	auto const transaction = ledger.tx_begin_read ();
-	for (auto i (store.confirmation_height.begin (transaction, last_account_a)), n (store.confirmation_height.end ()); i != n && !finish_transaction;)
-	{
+	store.confirmation_height.for_each_range (transaction, last_account_a, 0, [&] (nano::account const & account, nano::confirmation_height_info const & info) {
 		++read_operations;
-		auto const & account (i->first);
-		nano::block_hash hash (i->second.frontier);
+		nano::block_hash hash (info.frontier);
 		uint64_t depth (0);
 		while (!hash.is_zero () && depth < max_depth_a)
 		{
@@ -1007,11 +1028,8 @@ bool nano::node::collect_ledger_pruning_targets (std::deque<nano::block_hash> &
 			last_account_a = account.number () + 1;
 			finish_transaction = true;
 		}
-		else
-		{
-			++i;
-		}
-	}
+		return !finish_transaction;
+	});
 	return !finish_transaction || last_account_a.is_zero ();
 }
 
@@ -51,6 +51,7 @@ class vote_cache_processor;
 class vote_router;
 class work_pool;
 class peer_history;
+class signature_checker;
 class thread_runner;
 
 namespace scheduler
@@ -149,6 +150,8 @@ public:
 	nano::logger logger;
 	std::unique_ptr<nano::thread_runner> runner_impl;
 	nano::thread_runner & runner;
+	std::unique_ptr<nano::transport::io_shards> io_shards_impl;
+	nano::transport::io_shards & io_shards;
 	boost::latch node_initialized_latch;
 	nano::network_params & network_params;
 	nano::stats stats;
@@ -178,6 +181,8 @@ public:
 	std::filesystem::path application_path;
 	nano::node_observers observers;
 	nano::port_mapping port_mapping;
+	std::unique_ptr<nano::signature_checker> checker_impl;
+	nano::signature_checker & checker;
 	nano::block_processor block_processor;
 	std::unique_ptr<nano::confirming_set> confirming_set_impl;
 	nano::confirming_set & confirming_set;
@@ -119,6 +119,10 @@ void nano::rep_crawler::validate_and_process (nano::unique_lock<nano::mutex> & l
 
 		lock.unlock ();
 
+		if (inserted || updated)
+		{
+			++generation_m;
+		}
 		if (inserted)
 		{
 			logger.info (nano::log::type::rep_crawler, "Found representative {} at {}", vote->account.to_account (), channel->to_string ());
@@ -198,6 +202,8 @@ void nano::rep_crawler::cleanup ()
 {
 	debug_assert (!mutex.try_lock ());
 
+	++generation_m;
+
 	// Evict reps with dead channels
 	erase_if (reps, [this] (rep_entry const & rep) {
 		if (!rep.channel->alive ())
@@ -390,6 +396,11 @@ bool nano::rep_crawler::is_pr (std::shared_ptr<nano::transport::channel> const &
 	return false;
 }
 
+uint64_t nano::rep_crawler::generation () const
+{
+	return generation_m;
+}
+
 bool nano::rep_crawler::process (std::shared_ptr<nano::vote> const & vote, std::shared_ptr<nano::transport::channel> const & channel)
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
@@ -487,6 +498,7 @@ void nano::rep_crawler::force_add_rep (const nano::account & account, const std:
 	release_assert (node.network_params.network.is_dev_network ());
 	nano::lock_guard<nano::mutex> lock{ mutex };
 	reps.emplace (rep_entry{ account, channel });
+	++generation_m;
 }
 
 // Only for tests
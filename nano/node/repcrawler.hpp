@@ -71,6 +71,9 @@ public:
 	/** Query if a peer manages a principle representative */
 	bool is_pr (std::shared_ptr<nano::transport::channel> const &) const;
 
+	/** Changes whenever representatives are added, moved or evicted, and on every periodic cleanup so weight changes are eventually reflected */
+	uint64_t generation () const;
+
 	/** Get total available weight from representatives */
 	nano::uint128_t total_weight () const;
 
@@ -176,6 +179,7 @@ private:
 	boost::circular_buffer<response_t> responses{ max_responses };
 
 	std::chrono::steady_clock::time_point last_query{};
+	std::atomic<uint64_t> generation_m{ 0 };
 
 	std::atomic<bool> stopped{ false };
 	nano::condition_variable condition;
@@ -158,7 +158,8 @@ void nano::request_aggregator::run_batch (nano::unique_lock<nano::mutex> & lock)
 
 		transaction.refresh_if_needed ();
 
-		if (!channel->max ())
+		// Replies are votes, check the queue they will be sent through
+		if (!channel->max (nano::transport::traffic_type::vote))
 		{
 			process (transaction, request, channel);
 		}
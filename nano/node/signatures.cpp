@@ -0,0 +1,131 @@
+#include <nano/lib/utility.hpp>
+#include <nano/node/signatures.hpp>
+
+#include <algorithm>
+
+/*
+ * signature_check_set
+ */
+
+void nano::signature_check_set::reserve (std::size_t size)
+{
+	keys.reserve (size);
+	messages.reserve (size);
+	signatures.reserve (size);
+}
+
+std::size_t nano::signature_check_set::add (nano::public_key const & key, nano::uint256_union const & message, nano::signature const & signature)
+{
+	keys.push_back (key);
+	messages.push_back (message);
+	signatures.push_back (signature);
+	return keys.size () - 1;
+}
+
+std::size_t nano::signature_check_set::size () const
+{
+	return keys.size ();
+}
+
+bool nano::signature_check_set::empty () const
+{
+	return keys.empty ();
+}
+
+bool nano::signature_check_set::valid (std::size_t index) const
+{
+	debug_assert (index < verifications.size ());
+	return index < verifications.size () && verifications[index] == 1;
+}
+
+/*
+ * signature_checker
+ */
+
+nano::signature_checker::signature_checker (unsigned num_threads) :
+	thread_pool{ num_threads, nano::thread_role::name::signature_checking }
+{
+}
+
+nano::signature_checker::~signature_checker ()
+{
+	stop ();
+}
+
+void nano::signature_checker::stop ()
+{
+	if (!stopped.exchange (true))
+	{
+		thread_pool.stop ();
+	}
+}
+
+void nano::signature_checker::verify (nano::signature_check_set & check)
+{
+	auto const size = check.size ();
+	check.verifications.assign (size, 0);
+
+	// Don't process anything else if we have stopped, entries are left marked as not verified
+	if (size == 0 || stopped)
+	{
+		return;
+	}
+
+	// Split the work equally over the thread pool and the calling thread
+	auto const parallelism = thread_pool.get_num_threads () + 1;
+	auto const chunk_size = std::max (min_chunk_size, (size + parallelism - 1) / parallelism);
+	auto const chunks = (size + chunk_size - 1) / chunk_size;
+
+	struct state_t
+	{
+		std::atomic<std::size_t> next{ 0 };
+		std::size_t completed{ 0 };
+		nano::mutex mutex;
+		nano::condition_variable condition;
+	};
+	auto state = std::make_shared<state_t> ();
+
+	// Chunks are claimed by whichever thread gets to them first. The calling thread keeps claiming chunks as well,
+	// so verification finishes even when the pool is stopped and queued tasks never run.
+	auto process = [this, &check, state, chunk_size, chunks, size] () {
+		for (auto index = state->next++; index < chunks; index = state->next++)
+		{
+			auto const start = index * chunk_size;
+			verify_batch (check, start, std::min (chunk_size, size - start));
+			{
+				nano::lock_guard<nano::mutex> guard{ state->mutex };
+				++state->completed;
+			}
+			state->condition.notify_all ();
+		}
+	};
+
+	for (auto i = 1u; i < chunks; ++i)
+	{
+		thread_pool.push_task (process);
+	}
+	process ();
+
+	nano::unique_lock<nano::mutex> lock{ state->mutex };
+	state->condition.wait (lock, [&state, chunks] () { return state->completed == chunks; });
+}
+
+void nano::signature_checker::verify_batch (nano::signature_check_set & check, std::size_t start, std::size_t size)
+{
+	std::vector<unsigned char const *> messages (size);
+	std::vector<std::size_t> lengths (size, sizeof (nano::uint256_union));
+	std::vector<unsigned char const *> keys (size);
+	std::vector<unsigned char const *> signatures (size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		messages[i] = check.messages[start + i].bytes.data ();
+		keys[i] = check.keys[start + i].bytes.data ();
+		signatures[i] = check.signatures[start + i].bytes.data ();
+	}
+	nano::validate_message_batch (messages.data (), lengths.data (), keys.data (), signatures.data (), size, check.verifications.data () + start);
+}
+
+std::unique_ptr<nano::container_info_component> nano::signature_checker::collect_container_info (std::string const & name) const
+{
+	return thread_pool.collect_container_info (name);
+}
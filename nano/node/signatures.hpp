@@ -0,0 +1,66 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/thread_pool.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace nano
+{
+class container_info_component;
+}
+
+namespace nano
+{
+/**
+ * Set of (public key, 32 byte message, signature) tuples to be verified together
+ */
+class signature_check_set final
+{
+public:
+	void reserve (std::size_t);
+	/** Returns the index of the inserted entry */
+	std::size_t add (nano::public_key const &, nano::uint256_union const & message, nano::signature const &);
+	std::size_t size () const;
+	bool empty () const;
+	/** Returns true if the entry at `index` carries a valid signature. Only meaningful after verification */
+	bool valid (std::size_t index) const;
+
+private:
+	std::vector<nano::public_key> keys;
+	std::vector<nano::uint256_union> messages;
+	std::vector<nano::signature> signatures;
+	std::vector<int> verifications;
+
+	friend class signature_checker;
+};
+
+/**
+ * Multi-threaded signature verification using the ed25519 batch verification kernel.
+ * Work is split into chunks which are picked up both by the worker threads and by the calling thread.
+ */
+class signature_checker final
+{
+public:
+	explicit signature_checker (unsigned num_threads);
+	~signature_checker ();
+
+	/** Blocks until every entry in the set is verified. Entries in a failed batch fall back to individual checks */
+	void verify (nano::signature_check_set &);
+	void stop ();
+
+	std::unique_ptr<nano::container_info_component> collect_container_info (std::string const & name) const;
+
+public:
+	/** Smallest chunk handed to a single thread, matches the internal batch size of ed25519-donna */
+	static std::size_t constexpr min_chunk_size = 64;
+
+private:
+	void verify_batch (nano::signature_check_set &, std::size_t start, std::size_t size);
+
+	std::atomic<bool> stopped{ false };
+	nano::thread_pool thread_pool;
+};
+}
@@ -8,6 +8,36 @@
 #include <boost/asio/ip/address_v6.hpp>
 #include <boost/format.hpp>
 
+namespace
+{
+/** Generic traffic is scheduled by what the message carries, explicitly requested types are kept */
+nano::transport::traffic_type classify (nano::message const & message, nano::transport::traffic_type requested)
+{
+	if (requested != nano::transport::traffic_type::generic)
+	{
+		return requested;
+	}
+	switch (message.type ())
+	{
+		case nano::message_type::confirm_ack:
+		{
+			auto const & vote = static_cast<nano::confirm_ack const &> (message).vote;
+			return vote && vote->is_final () ? nano::transport::traffic_type::vote_final : nano::transport::traffic_type::vote;
+		}
+		case nano::message_type::publish:
+			return nano::transport::traffic_type::block;
+		case nano::message_type::telemetry_req:
+		case nano::message_type::telemetry_ack:
+			return nano::transport::traffic_type::telemetry;
+		case nano::message_type::asc_pull_req:
+		case nano::message_type::asc_pull_ack:
+			return nano::transport::traffic_type::bootstrap;
+		default:
+			return requested;
+	}
+}
+}
+
 nano::transport::channel::channel (nano::node & node_a) :
 	node{ node_a }
 {
@@ -16,7 +46,12 @@ nano::transport::channel::channel (nano::node & node_a) :
 
 void nano::transport::channel::send (nano::message & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, nano::transport::buffer_drop_policy drop_policy_a, nano::transport::traffic_type traffic_type)
 {
-	auto buffer = message_a.to_shared_const_buffer ();
+	send (message_a, message_a.to_shared_const_buffer (), callback_a, drop_policy_a, traffic_type);
+}
+
+void nano::transport::channel::send (nano::message const & message_a, nano::shared_const_buffer const & buffer, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, nano::transport::buffer_drop_policy drop_policy_a, nano::transport::traffic_type traffic_type)
+{
+	traffic_type = classify (message_a, traffic_type);
 
 	bool is_droppable_by_limiter = (drop_policy_a == nano::transport::buffer_drop_policy::limiter);
 	bool should_pass = node.outbound_limiter.should_pass (buffer.size (), to_bandwidth_limit_type (traffic_type));
@@ -31,6 +31,16 @@ public:
 	nano::transport::buffer_drop_policy policy_a = nano::transport::buffer_drop_policy::limiter,
 	nano::transport::traffic_type = nano::transport::traffic_type::generic);
 
+	/**
+	 * Sends `message_a` using its already serialized form in `buffer_a`.
+	 * Broadcasts serialize a message once and share the same buffer between all channels, stats and limiter are still accounted per channel.
+	 */
+	void send (nano::message const & message_a,
+	nano::shared_const_buffer const & buffer_a,
+	std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a = nullptr,
+	nano::transport::buffer_drop_policy policy_a = nano::transport::buffer_drop_policy::limiter,
+	nano::transport::traffic_type = nano::transport::traffic_type::generic);
+
 	// TODO: investigate clang-tidy warning about default parameters on virtual/override functions
 	virtual void send_buffer (nano::shared_const_buffer const &,
 	std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr,
@@ -3,6 +3,8 @@
 namespace nano::transport
 {
 class channel;
+class io_shard;
+class io_shards;
 class tcp_channel;
 class tcp_channels;
 class tcp_socket;
@@ -0,0 +1,120 @@
+#include <nano/boost/asio/post.hpp>
+#include <nano/lib/thread_runner.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/node/transport/io_shards.hpp>
+
+/*
+ * io_shard
+ */
+
+nano::transport::io_shard::io_shard (unsigned index_a, nano::logger & logger_a) :
+	index{ index_a },
+	io_ctx{ std::make_shared<boost::asio::io_context> (1) }
+{
+	// Queued ahead of everything else, so it runs on the shard thread before any socket is served
+	boost::asio::post (*io_ctx, [core = index_a % nano::hardware_concurrency ()] () {
+		nano::thread_pin_to_core (core);
+	});
+	runner = std::make_unique<nano::thread_runner> (io_ctx, logger_a, 1, nano::thread_role::name::io_shard);
+}
+
+nano::transport::io_shard::~io_shard ()
+{
+	// Sockets may release the last reference after the node is gone, the runner has to be released by io_shards::stop before that
+	debug_assert (!runner);
+	join ();
+}
+
+void nano::transport::io_shard::join ()
+{
+	if (runner)
+	{
+		runner->join ();
+		runner.reset ();
+	}
+}
+
+boost::asio::io_context & nano::transport::io_shard::context () const
+{
+	return *io_ctx;
+}
+
+std::size_t nano::transport::io_shard::load () const
+{
+	return sockets;
+}
+
+/*
+ * io_shards
+ */
+
+nano::transport::io_shards::io_shards (unsigned count_a, nano::logger & logger_a)
+{
+	for (auto index = 0u; index < count_a; ++index)
+	{
+		shards.push_back (std::make_shared<io_shard> (index, logger_a));
+	}
+}
+
+nano::transport::io_shards::~io_shards ()
+{
+	stop ();
+}
+
+void nano::transport::io_shards::stop ()
+{
+	for (auto const & shard : shards)
+	{
+		shard->join ();
+	}
+}
+
+bool nano::transport::io_shards::enabled () const
+{
+	return !shards.empty ();
+}
+
+std::size_t nano::transport::io_shards::size () const
+{
+	return shards.size ();
+}
+
+std::size_t nano::transport::io_shards::load () const
+{
+	std::size_t result = 0;
+	for (auto const & shard : shards)
+	{
+		result += shard->load ();
+	}
+	return result;
+}
+
+auto nano::transport::io_shards::select () -> std::shared_ptr<io_shard>
+{
+	if (shards.empty ())
+	{
+		return nullptr;
+	}
+	// Rotating the starting point spreads a burst of connections that all observe the same load
+	auto const start = next++;
+	auto best = shards[start % shards.size ()];
+	for (auto i = 1u; i < shards.size (); ++i)
+	{
+		auto const & shard = shards[(start + i) % shards.size ()];
+		if (shard->load () < best->load ())
+		{
+			best = shard;
+		}
+	}
+	return best;
+}
+
+std::unique_ptr<nano::container_info_component> nano::transport::io_shards::collect_container_info (std::string const & name) const
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	for (auto const & shard : shards)
+	{
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "shard_" + std::to_string (shard->index), shard->load (), 0 }));
+	}
+	return composite;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <nano/boost/asio/io_context.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+class container_info_component;
+class logger;
+class thread_runner;
+}
+
+namespace nano::transport
+{
+/**
+ * Single threaded io_context, pinned to a CPU core, serving a subset of peer sockets
+ */
+class io_shard final
+{
+public:
+	io_shard (unsigned index, nano::logger &);
+	~io_shard ();
+
+	/** Stops the shard thread and releases its runner, which refers to the node's logger */
+	void join ();
+
+	boost::asio::io_context & context () const;
+	/** Number of live sockets homed on this shard */
+	std::size_t load () const;
+
+public:
+	unsigned const index;
+
+private:
+	std::shared_ptr<boost::asio::io_context> io_ctx;
+	std::unique_ptr<nano::thread_runner> runner;
+	std::atomic<std::size_t> sockets{ 0 };
+
+	friend class tcp_socket;
+};
+
+/**
+ * Spreads peer connections over a fixed set of io_shards so each socket strand is scheduled by a single thread instead of competing on the shared io_context.
+ * Sockets never migrate between shards, anything crossing shards goes through message_processor.
+ */
+class io_shards final
+{
+public:
+	io_shards (unsigned count, nano::logger &);
+	~io_shards ();
+
+	/** Joins all shard threads. Shards can outlive this object and the node through the sockets homed on them, only their io_context is left after stopping */
+	void stop ();
+
+	bool enabled () const;
+	std::size_t size () const;
+	/** Total number of live sockets across all shards */
+	std::size_t load () const;
+
+	/** Picks the shard with the fewest live sockets, ties are broken round robin. Returns nullptr when sharding is disabled */
+	std::shared_ptr<io_shard> select ();
+
+	std::unique_ptr<nano::container_info_component> collect_container_info (std::string const & name) const;
+
+private:
+	std::vector<std::shared_ptr<io_shard>> shards;
+	std::atomic<std::size_t> next{ 0 };
+};
+}
@@ -1,20 +1,36 @@
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/lib/enum_util.hpp>
 #include <nano/node/node.hpp>
 #include <nano/node/transport/message_deserializer.hpp>
 
-nano::transport::message_deserializer::message_deserializer (nano::network_constants const & network_constants_a, nano::network_filter & publish_filter_a, nano::block_uniquer & block_uniquer_a, nano::vote_uniquer & vote_uniquer_a,
-read_query read_op) :
-	read_buffer{ std::make_shared<std::vector<uint8_t>> () },
+#include <cstring>
+
+nano::transport::message_deserializer::message_deserializer (nano::network_constants const & network_constants_a, nano::network_filter & publish_filter_a, nano::network_filter & vote_filter_a, nano::block_uniquer & block_uniquer_a, nano::vote_uniquer & vote_uniquer_a,
+read_query read_op, read_some_query read_some_op) :
+	read_buffer{ nano::buffer_pool::instance ().acquire (MAX_MESSAGE_SIZE) },
 	network_constants_m{ network_constants_a },
 	publish_filter_m{ publish_filter_a },
+	vote_filter_m{ vote_filter_a },
 	block_uniquer_m{ block_uniquer_a },
 	vote_uniquer_m{ vote_uniquer_a },
-	read_op{ std::move (read_op) }
+	read_op{ std::move (read_op) },
+	read_some_op{ std::move (read_some_op) }
 {
 	debug_assert (this->read_op);
 	read_buffer->resize (MAX_MESSAGE_SIZE);
 }
 
+void nano::transport::message_deserializer::enable_buffering ()
+{
+	debug_assert (read_some_op);
+	if (!buffered && read_some_op)
+	{
+		buffered = true;
+		read_buffer = nano::buffer_pool::instance ().acquire (BUFFER_SIZE);
+		read_buffer->resize (BUFFER_SIZE);
+	}
+}
+
 void nano::transport::message_deserializer::read (const nano::transport::message_deserializer::callback_type && callback)
 {
 	debug_assert (callback);
@@ -22,6 +38,12 @@ void nano::transport::message_deserializer::read (const nano::transport::message
 
 	status = parse_status::none;
 
+	if (buffered)
+	{
+		read_buffered (std::move (callback));
+		return;
+	}
+
 	read_op (read_buffer, HEADER_SIZE, [this_l = shared_from_this (), callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
 		if (ec)
 		{
@@ -39,52 +61,25 @@ void nano::transport::message_deserializer::read (const nano::transport::message
 
 void nano::transport::message_deserializer::received_header (const nano::transport::message_deserializer::callback_type && callback)
 {
-	nano::bufferstream stream{ read_buffer->data (), HEADER_SIZE };
-	auto error = false;
-	nano::message_header header{ error, stream };
-	if (error)
-	{
-		status = parse_status::invalid_header;
-		callback (boost::asio::error::fault, nullptr);
-		return;
-	}
-	if (header.network != network_constants_m.current_network)
-	{
-		status = parse_status::invalid_network;
-		callback (boost::asio::error::fault, nullptr);
-		return;
-	}
-	if (header.version_using < network_constants_m.protocol_version_min)
-	{
-		status = parse_status::outdated_version;
-		callback (boost::asio::error::fault, nullptr);
-		return;
-	}
-	if (!header.is_valid_message_type ())
+	auto header = parse_header (read_buffer->data ());
+	if (!header)
 	{
-		status = parse_status::invalid_header;
 		callback (boost::asio::error::fault, nullptr);
 		return;
 	}
 
-	std::size_t payload_size = header.payload_length_bytes ();
-	if (payload_size > MAX_MESSAGE_SIZE)
-	{
-		status = parse_status::message_size_too_big;
-		callback (boost::asio::error::fault, nullptr);
-		return;
-	}
+	std::size_t payload_size = header->payload_length_bytes ();
 	debug_assert (payload_size <= read_buffer->capacity ());
 
 	if (payload_size == 0)
 	{
 		// Payload size will be 0 for `bulk_push` & `telemetry_req` message type
-		received_message (header, 0, std::move (callback));
+		received_message (*header, 0, std::move (callback));
 	}
 	else
 	{
 		debug_assert (read_op);
-		read_op (read_buffer, payload_size, [this_l = shared_from_this (), payload_size, header, callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
+		read_op (read_buffer, payload_size, [this_l = shared_from_this (), payload_size, header = *header, callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
 			if (ec)
 			{
 				callback (ec, nullptr);
@@ -102,7 +97,99 @@ void nano::transport::message_deserializer::received_header (const nano::transpo
 
 void nano::transport::message_deserializer::received_message (nano::message_header header, std::size_t payload_size, const nano::transport::message_deserializer::callback_type && callback)
 {
-	auto message = deserialize (header, payload_size);
+	finish (deserialize (header, read_buffer->data (), payload_size), callback);
+}
+
+void nano::transport::message_deserializer::read_buffered (const nano::transport::message_deserializer::callback_type && callback)
+{
+	debug_assert (buffered);
+	debug_assert (buffer_begin <= buffer_end && buffer_end <= read_buffer->size ());
+
+	auto const available = buffer_end - buffer_begin;
+	std::size_t required = HEADER_SIZE;
+	if (available >= HEADER_SIZE)
+	{
+		auto header = parse_header (read_buffer->data () + buffer_begin);
+		if (!header)
+		{
+			callback (boost::asio::error::fault, nullptr);
+			return;
+		}
+		std::size_t payload_size = header->payload_length_bytes ();
+		required = HEADER_SIZE + payload_size;
+		if (available >= required)
+		{
+			if (buffered_messages >= MAX_BUFFERED_MESSAGES)
+			{
+				// Go through the socket once before continuing, callers read the next message from inside the callback
+				buffered_messages = 0;
+				read_some_op (read_buffer, buffer_end, 0, [this_l = shared_from_this (), callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t) {
+					if (ec)
+					{
+						callback (ec, nullptr);
+						return;
+					}
+					this_l->read_buffered (std::move (callback));
+				});
+				return;
+			}
+			++buffered_messages;
+
+			auto message = deserialize (*header, read_buffer->data () + buffer_begin + HEADER_SIZE, payload_size);
+			buffer_begin += required;
+			if (buffer_begin == buffer_end)
+			{
+				// Drained, give back memory grown for large messages
+				buffer_begin = buffer_end = 0;
+				if (read_buffer->size () > BUFFER_SIZE)
+				{
+					read_buffer = nano::buffer_pool::instance ().acquire (BUFFER_SIZE);
+					read_buffer->resize (BUFFER_SIZE);
+				}
+			}
+			finish (std::move (message), callback);
+			return;
+		}
+	}
+
+	// Incomplete message, move what is left to the front and make room for the rest
+	if (buffer_begin > 0)
+	{
+		std::memmove (read_buffer->data (), read_buffer->data () + buffer_begin, available);
+		buffer_begin = 0;
+		buffer_end = available;
+	}
+	if (read_buffer->capacity () < required)
+	{
+		// Move to a pooled buffer large enough for the message instead of growing this one
+		auto larger = nano::buffer_pool::instance ().acquire (required);
+		larger->assign (read_buffer->begin (), read_buffer->begin () + buffer_end);
+		read_buffer = std::move (larger);
+	}
+	if (read_buffer->size () < required)
+	{
+		read_buffer->resize (required);
+	}
+	buffered_messages = 0;
+
+	read_some_op (read_buffer, buffer_end, read_buffer->size () - buffer_end, [this_l = shared_from_this (), callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
+		if (ec)
+		{
+			callback (ec, nullptr);
+			return;
+		}
+		if (size_a == 0)
+		{
+			callback (boost::asio::error::fault, nullptr);
+			return;
+		}
+		this_l->buffer_end += size_a;
+		this_l->read_buffered (std::move (callback));
+	});
+}
+
+void nano::transport::message_deserializer::finish (std::unique_ptr<nano::message> message, const nano::transport::message_deserializer::callback_type & callback)
+{
 	if (message)
 	{
 		debug_assert (status == parse_status::none);
@@ -116,10 +203,43 @@ void nano::transport::message_deserializer::received_message (nano::message_head
 	}
 }
 
-std::unique_ptr<nano::message> nano::transport::message_deserializer::deserialize (nano::message_header header, std::size_t payload_size)
+std::optional<nano::message_header> nano::transport::message_deserializer::parse_header (uint8_t const * data)
+{
+	nano::bufferstream stream{ data, HEADER_SIZE };
+	auto error = false;
+	nano::message_header header{ error, stream };
+	if (error)
+	{
+		status = parse_status::invalid_header;
+		return std::nullopt;
+	}
+	if (header.network != network_constants_m.current_network)
+	{
+		status = parse_status::invalid_network;
+		return std::nullopt;
+	}
+	if (header.version_using < network_constants_m.protocol_version_min)
+	{
+		status = parse_status::outdated_version;
+		return std::nullopt;
+	}
+	if (!header.is_valid_message_type ())
+	{
+		status = parse_status::invalid_header;
+		return std::nullopt;
+	}
+	if (header.payload_length_bytes () > MAX_MESSAGE_SIZE)
+	{
+		status = parse_status::message_size_too_big;
+		return std::nullopt;
+	}
+	return header;
+}
+
+std::unique_ptr<nano::message> nano::transport::message_deserializer::deserialize (nano::message_header header, uint8_t const * data, std::size_t payload_size)
 {
 	release_assert (payload_size <= MAX_MESSAGE_SIZE);
-	nano::bufferstream stream{ read_buffer->data (), payload_size };
+	nano::bufferstream stream{ data, payload_size };
 	switch (header.type)
 	{
 		case nano::message_type::keepalive:
@@ -130,7 +250,7 @@ std::unique_ptr<nano::message> nano::transport::message_deserializer::deserializ
 		{
 			// Early filtering to not waste time deserializing duplicate blocks
 			nano::uint128_t digest;
-			if (!publish_filter_m.apply (read_buffer->data (), payload_size, &digest))
+			if (!publish_filter_m.apply (data, payload_size, &digest))
 			{
 				return deserialize_publish (stream, header, digest);
 			}
@@ -146,7 +266,20 @@ std::unique_ptr<nano::message> nano::transport::message_deserializer::deserializ
 		}
 		case nano::message_type::confirm_ack:
 		{
-			return deserialize_confirm_ack (stream, header);
+			// Every vote is recorded, but only rebroadcasted copies are dropped. Live votes keep flowing so the rep crawler sees replies from each representative's own channel.
+			nano::uint128_t digest;
+			auto const duplicate = vote_filter_m.apply (data, payload_size, &digest);
+			if (duplicate && header.flag_test (nano::confirm_ack::rebroadcasted_flag))
+			{
+				status = parse_status::duplicate_confirm_ack_message;
+				break;
+			}
+			auto incoming = deserialize_confirm_ack (stream, header);
+			if (incoming)
+			{
+				incoming->digest = digest;
+			}
+			return incoming;
 		}
 		case nano::message_type::node_id_handshake:
 		{
@@ -4,6 +4,7 @@
 #include <nano/node/messages.hpp>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace nano
@@ -32,6 +33,7 @@ namespace transport
 		invalid_network,
 		outdated_version,
 		duplicate_publish_message,
+		duplicate_confirm_ack_message,
 		message_size_too_big,
 	};
 
@@ -43,7 +45,9 @@ namespace transport
 		parse_status status;
 
 		using read_query = std::function<void (std::shared_ptr<std::vector<uint8_t>> const &, size_t, std::function<void (boost::system::error_code const &, std::size_t)>)>;
-		message_deserializer (network_constants const &, network_filter &, block_uniquer &, vote_uniquer &, read_query read_op);
+		/** Reads at least one and at most `size` bytes into the buffer starting at `offset`. A `size` of zero only defers the callback */
+		using read_some_query = std::function<void (std::shared_ptr<std::vector<uint8_t>> const &, size_t offset, size_t size, std::function<void (boost::system::error_code const &, std::size_t)>)>;
+		message_deserializer (network_constants const &, network_filter & publish_filter, network_filter & vote_filter, block_uniquer &, vote_uniquer &, read_query read_op, read_some_query read_some_op = nullptr);
 
 		/*
 		 * Asynchronously read next message from the channel_read_fn.
@@ -54,15 +58,29 @@ namespace transport
 		 */
 		void read (callback_type const && callback);
 
+		/*
+		 * Switches to buffered reads: whatever bytes are available are read into `read_buffer` and as many complete messages as it holds are parsed before going back to the socket.
+		 * Bytes following the current message may be consumed, so this must only be enabled once nothing else reads from the connection directly.
+		 * Requires `read_some_op`.
+		 */
+		void enable_buffering ();
+
 	private:
 		void received_header (callback_type const && callback);
 		void received_message (nano::message_header header, std::size_t payload_size, callback_type const && callback);
+		void read_buffered (callback_type const && callback);
+		void finish (std::unique_ptr<nano::message> message, callback_type const & callback);
 
 		/*
-		 * Deserializes message using data in `read_buffer`.
+		 * Validates the header at `data`.
+		 * @return If successful returns the header, otherwise sets `status` to error appropriate code and returns nullopt
+		 */
+		std::optional<nano::message_header> parse_header (uint8_t const * data);
+		/*
+		 * Deserializes message using the payload at `data`.
 		 * @return If successful returns non-null message, otherwise sets `status` to error appropriate code and returns nullptr
 		 */
-		std::unique_ptr<nano::message> deserialize (nano::message_header header, std::size_t payload_size);
+		std::unique_ptr<nano::message> deserialize (nano::message_header header, uint8_t const * data, std::size_t payload_size);
 		std::unique_ptr<nano::keepalive> deserialize_keepalive (nano::stream &, nano::message_header const &);
 		std::unique_ptr<nano::publish> deserialize_publish (nano::stream &, nano::message_header const &, nano::uint128_t const & = 0);
 		std::unique_ptr<nano::confirm_req> deserialize_confirm_req (nano::stream &, nano::message_header const &);
@@ -78,17 +96,29 @@ namespace transport
 		std::unique_ptr<nano::asc_pull_ack> deserialize_asc_pull_ack (nano::stream &, nano::message_header const &);
 
 		std::shared_ptr<std::vector<uint8_t>> read_buffer;
+		// Unparsed bytes in `read_buffer` when buffering
+		std::size_t buffer_begin{ 0 };
+		std::size_t buffer_end{ 0 };
+		// Messages handed out from the buffer since the last socket read
+		std::size_t buffered_messages{ 0 };
+		bool buffered{ false };
 
 	private: // Constants
 		static constexpr std::size_t HEADER_SIZE = 8;
 		static constexpr std::size_t MAX_MESSAGE_SIZE = 1024 * 65;
+		// Buffer kept by buffered connections between messages, grown to fit larger messages and shrunk back once drained
+		static constexpr std::size_t BUFFER_SIZE = 1024 * 8;
+		// Messages parsed from the buffer in a row before yielding through `read_some_op`, bounds recursion through callbacks
+		static constexpr std::size_t MAX_BUFFERED_MESSAGES = 64;
 
 	private: // Dependencies
 		nano::network_constants const & network_constants_m;
 		nano::network_filter & publish_filter_m;
+		nano::network_filter & vote_filter_m;
 		nano::block_uniquer & block_uniquer_m;
 		nano::vote_uniquer & vote_uniquer_m;
 		read_query read_op;
+		read_some_query read_some_op;
 	};
 
 	nano::stat::detail to_stat_detail (parse_status);
@@ -48,6 +48,7 @@ void nano::transport::tcp_channels::close ()
 	}
 
 	channels.clear ();
+	publish_snapshot ();
 }
 
 bool nano::transport::tcp_channels::check (const nano::tcp_endpoint & endpoint, const nano::account & node_id) const
@@ -125,6 +126,7 @@ std::shared_ptr<nano::transport::tcp_channel> nano::transport::tcp_channels::cre
 
 	auto [_, inserted] = channels.get<endpoint_tag> ().emplace (channel, socket, server);
 	debug_assert (inserted);
+	publish_snapshot ();
 
 	lock.unlock ();
 
@@ -136,7 +138,10 @@ std::shared_ptr<nano::transport::tcp_channel> nano::transport::tcp_channels::cre
 void nano::transport::tcp_channels::erase (nano::tcp_endpoint const & endpoint_a)
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
-	channels.get<endpoint_tag> ().erase (endpoint_a);
+	if (channels.get<endpoint_tag> ().erase (endpoint_a) > 0)
+	{
+		publish_snapshot ();
+	}
 }
 
 std::size_t nano::transport::tcp_channels::size () const
@@ -161,31 +166,49 @@ std::unordered_set<std::shared_ptr<nano::transport::channel>> nano::transport::t
 {
 	std::unordered_set<std::shared_ptr<nano::transport::channel>> result;
 	result.reserve (count_a);
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	// Stop trying to fill result with random samples after this many attempts
-	auto random_cutoff (count_a * 2);
-	// Usually count_a will be much smaller than peers.size()
-	// Otherwise make sure we have a cutoff on attempting to randomly fill
-	if (!channels.empty ())
+	for (auto & channel : sample (count_a, min_version))
 	{
-		for (auto i (0); i < random_cutoff && result.size () < count_a; ++i)
-		{
-			auto index = rng.random (channels.size ());
-			auto channel = channels.get<random_access_tag> ()[index].channel;
-			if (!channel->alive ())
-			{
-				continue;
-			}
-
-			if (channel->get_network_version () >= min_version)
-			{
-				result.insert (channel);
-			}
-		}
+		result.insert (std::move (channel));
 	}
 	return result;
 }
 
+std::deque<std::shared_ptr<nano::transport::channel>> nano::transport::tcp_channels::sample (std::size_t count_a, uint8_t minimum_version_a) const
+{
+	// Each thread draws from its own generator so sampling never contends
+	thread_local nano::random_generator sample_rng;
+
+	auto const current = snapshot ();
+	auto const count = count_a > 0 ? count_a : current->channels.size ();
+	std::deque<std::shared_ptr<nano::transport::channel>> result;
+	nano::random_sample (
+	current->channels, count, sample_rng,
+	[minimum_version_a] (auto const & channel) { return channel->alive () && channel->get_network_version () >= minimum_version_a; },
+	[&result] (auto const & channel) { result.push_back (channel); });
+	return result;
+}
+
+std::shared_ptr<nano::transport::tcp_channels::snapshot_t const> nano::transport::tcp_channels::snapshot () const
+{
+	nano::lock_guard<nano::mutex> guard{ snapshot_mutex };
+	return snapshot_m;
+}
+
+void nano::transport::tcp_channels::publish_snapshot ()
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto updated = std::make_shared<snapshot_t> ();
+	updated->channels.reserve (channels.size ());
+	for (auto const & entry : channels.get<random_access_tag> ())
+	{
+		updated->channels.push_back (entry.channel);
+	}
+
+	nano::lock_guard<nano::mutex> guard{ snapshot_mutex };
+	snapshot_m = std::move (updated);
+}
+
 void nano::transport::tcp_channels::random_fill (std::array<nano::endpoint, 8> & target_a) const
 {
 	auto peers (random_set (target_a.size ()));
@@ -363,6 +386,7 @@ void nano::transport::tcp_channels::purge (std::chrono::steady_clock::time_point
 		}
 	}
 
+	auto const size_before = channels.size ();
 	erase_if (channels, [this] (auto const & entry) {
 		if (!entry.channel->alive ())
 		{
@@ -371,6 +395,10 @@ void nano::transport::tcp_channels::purge (std::chrono::steady_clock::time_point
 		}
 		return false;
 	});
+	if (channels.size () != size_before)
+	{
+		publish_snapshot ();
+	}
 
 	// Remove keepalive attempt tracking for attempts older than cutoff
 	auto attempts_cutoff (attempts.get<last_attempt_tag> ().lower_bound (cutoff_deadline));
@@ -426,11 +454,11 @@ std::optional<nano::keepalive> nano::transport::tcp_channels::sample_keepalive (
 
 void nano::transport::tcp_channels::list (std::deque<std::shared_ptr<nano::transport::channel>> & deque_a, uint8_t minimum_version_a, bool include_temporary_channels_a)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto const current = snapshot ();
 	// clang-format off
-	nano::transform_if (channels.get<random_access_tag> ().begin (), channels.get<random_access_tag> ().end (), std::back_inserter (deque_a),
-		[include_temporary_channels_a, minimum_version_a](auto & channel_a) { return channel_a.channel->get_network_version () >= minimum_version_a; },
-		[](auto const & channel) { return channel.channel; });
+	nano::transform_if (current->channels.begin (), current->channels.end (), std::back_inserter (deque_a),
+		[include_temporary_channels_a, minimum_version_a](auto & channel_a) { return channel_a->get_network_version () >= minimum_version_a; },
+		[](auto const & channel) { return channel; });
 	// clang-format on
 }
 
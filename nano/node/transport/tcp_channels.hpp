@@ -51,6 +51,8 @@ public:
 	std::unique_ptr<container_info_component> collect_container_info (std::string const &);
 	void purge (std::chrono::steady_clock::time_point cutoff_deadline);
 	void list (std::deque<std::shared_ptr<nano::transport::channel>> &, uint8_t = 0, bool = true);
+	/** Up to `count` (all if 0) random live channels of at least `minimum_version`, drawn from the snapshot without taking the channels mutex */
+	std::deque<std::shared_ptr<nano::transport::channel>> sample (std::size_t count, uint8_t minimum_version = 0) const;
 	void modify (std::shared_ptr<nano::transport::tcp_channel> const &, std::function<void (std::shared_ptr<nano::transport::tcp_channel> const &)>);
 	void keepalive ();
 	std::optional<nano::keepalive> sample_keepalive ();
@@ -58,12 +60,23 @@ public:
 	// Connection start
 	void start_tcp (nano::endpoint const &);
 
+public:
+	/** Immutable view of the channel set, republished whenever channels are added or removed */
+	class snapshot_t final
+	{
+	public:
+		std::vector<std::shared_ptr<nano::transport::tcp_channel>> channels;
+	};
+	std::shared_ptr<snapshot_t const> snapshot () const;
+
 private: // Dependencies
 	nano::node & node;
 
 private:
 	void close ();
 	bool check (nano::tcp_endpoint const &, nano::account const & node_id) const;
+	/** Rebuilds the snapshot from `channels`, must be called with `mutex` held after every insertion or removal */
+	void publish_snapshot ();
 
 private:
 	class channel_entry final
@@ -168,6 +181,10 @@ private:
 	nano::condition_variable condition;
 	mutable nano::mutex mutex;
 
+	// Only guards swapping the pointer, readers never hold it for longer than a shared_ptr copy
+	mutable nano::mutex snapshot_mutex;
+	std::shared_ptr<snapshot_t const> snapshot_m{ std::make_shared<snapshot_t> () };
+
 	mutable nano::random_generator rng;
 };
 }
\ No newline at end of file
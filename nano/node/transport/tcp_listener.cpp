@@ -2,6 +2,7 @@
 #include <nano/lib/interval.hpp>
 #include <nano/node/messages.hpp>
 #include <nano/node/node.hpp>
+#include <nano/node/transport/io_shards.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/transport/tcp_server.hpp>
 
@@ -276,10 +277,11 @@ auto nano::transport::tcp_listener::connect_impl (asio::ip::tcp::endpoint endpoi
 
 	try
 	{
-		auto raw_socket = co_await connect_socket (endpoint);
+		auto shard = node.io_shards.select ();
+		auto raw_socket = co_await connect_socket (endpoint, shard);
 		debug_assert (strand.running_in_this_thread ());
 
-		auto result = accept_one (std::move (raw_socket), connection_type::outbound);
+		auto result = accept_one (std::move (raw_socket), connection_type::outbound, shard);
 		if (result.result == accept_result::accepted)
 		{
 			stats.inc (nano::stat::type::tcp_listener, nano::stat::detail::connect_success, nano::stat::dir::out);
@@ -311,10 +313,11 @@ asio::awaitable<void> nano::transport::tcp_listener::run ()
 
 		try
 		{
-			auto socket = co_await accept_socket ();
+			auto shard = node.io_shards.select ();
+			auto socket = co_await accept_socket (shard);
 			debug_assert (strand.running_in_this_thread ());
 
-			auto result = accept_one (std::move (socket), connection_type::inbound);
+			auto result = accept_one (std::move (socket), connection_type::inbound, shard);
 			if (result.result != accept_result::accepted)
 			{
 				stats.inc (nano::stat::type::tcp_listener, nano::stat::detail::accept_failure, nano::stat::dir::in);
@@ -337,18 +340,25 @@ asio::awaitable<void> nano::transport::tcp_listener::run ()
 	}
 }
 
-asio::awaitable<asio::ip::tcp::socket> nano::transport::tcp_listener::accept_socket ()
+asio::awaitable<asio::ip::tcp::socket> nano::transport::tcp_listener::accept_socket (std::shared_ptr<nano::transport::io_shard> const & shard)
 {
 	debug_assert (strand.running_in_this_thread ());
 
+	if (shard)
+	{
+		// Accept straight onto the shard io_context, the completion still resumes this coroutine on the listener strand
+		asio::ip::tcp::socket raw_socket{ shard->context () };
+		co_await acceptor.async_accept (raw_socket, asio::use_awaitable);
+		co_return raw_socket;
+	}
 	co_return co_await acceptor.async_accept (asio::use_awaitable);
 }
 
-asio::awaitable<asio::ip::tcp::socket> nano::transport::tcp_listener::connect_socket (asio::ip::tcp::endpoint endpoint)
+asio::awaitable<asio::ip::tcp::socket> nano::transport::tcp_listener::connect_socket (asio::ip::tcp::endpoint endpoint, std::shared_ptr<nano::transport::io_shard> const & shard)
 {
 	debug_assert (strand.running_in_this_thread ());
 
-	asio::ip::tcp::socket raw_socket{ strand };
+	auto raw_socket = shard ? asio::ip::tcp::socket{ shard->context () } : asio::ip::tcp::socket{ strand };
 	co_await raw_socket.async_connect (endpoint, asio::use_awaitable);
 
 	co_return raw_socket;
@@ -369,7 +379,7 @@ asio::awaitable<void> nano::transport::tcp_listener::wait_available_slots () con
 	}
 }
 
-auto nano::transport::tcp_listener::accept_one (asio::ip::tcp::socket raw_socket, connection_type type) -> accept_return
+auto nano::transport::tcp_listener::accept_one (asio::ip::tcp::socket raw_socket, connection_type type, std::shared_ptr<nano::transport::io_shard> shard) -> accept_return
 {
 	auto const remote_endpoint = raw_socket.remote_endpoint ();
 	auto const local_endpoint = raw_socket.local_endpoint ();
@@ -405,7 +415,7 @@ auto nano::transport::tcp_listener::accept_one (asio::ip::tcp::socket raw_socket
 	stats.inc (nano::stat::type::tcp_listener, nano::stat::detail::accept_success, to_stat_dir (type));
 	logger.debug (nano::log::type::tcp_listener, "Accepted connection: {} ({})", fmt::streamed (remote_endpoint), to_string (type));
 
-	auto socket = std::make_shared<nano::transport::tcp_socket> (node, std::move (raw_socket), remote_endpoint, local_endpoint, to_socket_endpoint (type));
+	auto socket = std::make_shared<nano::transport::tcp_socket> (node, std::move (raw_socket), remote_endpoint, local_endpoint, to_socket_endpoint (type), nano::transport::tcp_socket::default_max_queue_size, std::move (shard));
 	auto server = std::make_shared<nano::transport::tcp_server> (socket, node.shared (), true);
 
 	connections.emplace_back (connection{ remote_endpoint, socket, server });
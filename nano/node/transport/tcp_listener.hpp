@@ -4,6 +4,7 @@
 #include <nano/node/common.hpp>
 #include <nano/node/fwd.hpp>
 #include <nano/node/transport/common.hpp>
+#include <nano/node/transport/tcp_socket.hpp>
 
 #include <boost/asio.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -46,6 +47,7 @@ public:
 	size_t max_attempts{ 60 };
 	size_t max_attempts_per_ip{ 1 };
 	std::chrono::seconds connect_timeout{ 60 };
+	nano::transport::socket_queue_config socket_queue;
 };
 
 /**
@@ -111,7 +113,7 @@ private:
 	};
 
 	asio::awaitable<void> connect_impl (asio::ip::tcp::endpoint);
-	asio::awaitable<asio::ip::tcp::socket> connect_socket (asio::ip::tcp::endpoint);
+	asio::awaitable<asio::ip::tcp::socket> connect_socket (asio::ip::tcp::endpoint, std::shared_ptr<nano::transport::io_shard> const &);
 
 	struct accept_return
 	{
@@ -120,9 +122,9 @@ private:
 		std::shared_ptr<nano::transport::tcp_server> server;
 	};
 
-	accept_return accept_one (asio::ip::tcp::socket, connection_type);
+	accept_return accept_one (asio::ip::tcp::socket, connection_type, std::shared_ptr<nano::transport::io_shard> = nullptr);
 	accept_result check_limits (asio::ip::address const & ip, connection_type);
-	asio::awaitable<asio::ip::tcp::socket> accept_socket ();
+	asio::awaitable<asio::ip::tcp::socket> accept_socket (std::shared_ptr<nano::transport::io_shard> const &);
 
 	size_t count_per_type (connection_type) const;
 	size_t count_per_ip (asio::ip::address const & ip) const;
@@ -17,10 +17,14 @@ nano::transport::tcp_server::tcp_server (std::shared_ptr<nano::transport::tcp_so
 	node{ node_a },
 	allow_bootstrap{ allow_bootstrap_a },
 	message_deserializer{
-		std::make_shared<nano::transport::message_deserializer> (node_a->network_params.network, node_a->network.publish_filter, node_a->block_uniquer, node_a->vote_uniquer,
+		std::make_shared<nano::transport::message_deserializer> (node_a->network_params.network, node_a->network.publish_filter, node_a->network.vote_filter, node_a->block_uniquer, node_a->vote_uniquer,
 		[socket_l = socket] (std::shared_ptr<std::vector<uint8_t>> const & data_a, size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a) {
 			debug_assert (socket_l != nullptr);
 			socket_l->read_impl (data_a, size_a, callback_a);
+		},
+		[socket_l = socket] (std::shared_ptr<std::vector<uint8_t>> const & data_a, size_t offset_a, size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a) {
+			debug_assert (socket_l != nullptr);
+			socket_l->read_some_impl (data_a, offset_a, size_a, callback_a);
 		})
 	}
 {
@@ -124,6 +128,10 @@ void nano::transport::tcp_server::received_message (std::unique_ptr<nano::messag
 		{
 			node->stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_publish_message);
 		}
+		else if (message_deserializer->status == transport::parse_status::duplicate_confirm_ack_message)
+		{
+			node->stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_confirm_ack_message);
+		}
 		else
 		{
 			node->logger.debug (nano::log::type::tcp_server, "Error deserializing message: {} ({})",
@@ -675,6 +683,9 @@ bool nano::transport::tcp_server::to_realtime_connection (nano::account const &
 
 	socket->type_set (nano::transport::socket_type::realtime);
 
+	// Realtime traffic is only ever read through the deserializer, so it can read ahead of the current message
+	message_deserializer->enable_buffering ();
+
 	node->logger.debug (nano::log::type::tcp_server, "Switched to realtime mode ({})", fmt::streamed (remote_endpoint));
 
 	return true;
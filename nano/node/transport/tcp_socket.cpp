@@ -2,11 +2,13 @@
 #include <nano/boost/asio/read.hpp>
 #include <nano/lib/enum_util.hpp>
 #include <nano/node/node.hpp>
+#include <nano/node/transport/io_shards.hpp>
 #include <nano/node/transport/tcp_socket.hpp>
 #include <nano/node/transport/transport.hpp>
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <iterator>
@@ -23,10 +25,11 @@ nano::transport::tcp_socket::tcp_socket (nano::node & node_a, nano::transport::s
 {
 }
 
-nano::transport::tcp_socket::tcp_socket (nano::node & node_a, boost::asio::ip::tcp::socket raw_socket_a, boost::asio::ip::tcp::endpoint remote_endpoint_a, boost::asio::ip::tcp::endpoint local_endpoint_a, nano::transport::socket_endpoint endpoint_type_a, std::size_t max_queue_size_a) :
-	send_queue{ max_queue_size_a },
+nano::transport::tcp_socket::tcp_socket (nano::node & node_a, boost::asio::ip::tcp::socket raw_socket_a, boost::asio::ip::tcp::endpoint remote_endpoint_a, boost::asio::ip::tcp::endpoint local_endpoint_a, nano::transport::socket_endpoint endpoint_type_a, std::size_t max_queue_size_a, std::shared_ptr<nano::transport::io_shard> shard_a) :
+	send_queue{ max_queue_size_a, node_a.config.tcp.socket_queue },
 	node_w{ node_a.shared () },
-	strand{ node_a.io_ctx.get_executor () },
+	shard{ std::move (shard_a) },
+	strand{ shard ? shard->context ().get_executor () : node_a.io_ctx.get_executor () },
 	raw_socket{ std::move (raw_socket_a) },
 	remote{ remote_endpoint_a },
 	local{ local_endpoint_a },
@@ -38,12 +41,21 @@ nano::transport::tcp_socket::tcp_socket (nano::node & node_a, boost::asio::ip::t
 	silent_connection_tolerance_time{ node_a.network_params.network.silent_connection_tolerance_time },
 	max_queue_size{ max_queue_size_a }
 {
+	debug_assert (!shard || &raw_socket.get_executor ().context () == &shard->context ());
+	if (shard)
+	{
+		++shard->sockets;
+	}
 }
 
 nano::transport::tcp_socket::~tcp_socket ()
 {
 	close_internal ();
 	closed = true;
+	if (shard)
+	{
+		--shard->sockets;
+	}
 }
 
 void nano::transport::tcp_socket::start ()
@@ -105,38 +117,81 @@ void nano::transport::tcp_socket::async_read (std::shared_ptr<std::vector<uint8_
 				boost::asio::async_read (this_l->raw_socket, boost::asio::buffer (buffer_a->data (), size_a),
 				boost::asio::bind_executor (this_l->strand,
 				[this_l, buffer_a, cbk = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
-					debug_assert (this_l->strand.running_in_this_thread ());
-
-					auto node_l = this_l->node_w.lock ();
-					if (!node_l)
+					if (this_l->read_completed (ec, size_a))
 					{
-						return;
+						cbk (ec, size_a);
 					}
+				}));
+			});
+		}
+	}
+	else
+	{
+		debug_assert (false && "nano::transport::tcp_socket::async_read called with incorrect buffer size");
+		boost::system::error_code ec_buffer = boost::system::errc::make_error_code (boost::system::errc::no_buffer_space);
+		callback_a (ec_buffer, 0);
+	}
+}
 
-					if (ec)
-					{
-						node_l->stats.inc (nano::stat::type::tcp, nano::stat::detail::tcp_read_error, nano::stat::dir::in);
-						this_l->close ();
-					}
-					else
+void nano::transport::tcp_socket::async_read_some (std::shared_ptr<std::vector<uint8_t>> const & buffer_a, std::size_t offset_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a)
+{
+	debug_assert (callback_a);
+
+	if (offset_a + size_a <= buffer_a->size ())
+	{
+		if (!closed)
+		{
+			set_default_timeout ();
+			boost::asio::post (strand, [this_l = shared_from_this (), buffer_a, callback = std::move (callback_a), offset_a, size_a] () mutable {
+				if (size_a == 0)
+				{
+					// Nothing to read, only defer the callback to the strand
+					callback (boost::system::error_code{}, 0);
+					return;
+				}
+				this_l->raw_socket.async_read_some (boost::asio::buffer (buffer_a->data () + offset_a, size_a),
+				boost::asio::bind_executor (this_l->strand,
+				[this_l, buffer_a, cbk = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
+					if (this_l->read_completed (ec, size_a))
 					{
-						node_l->stats.add (nano::stat::type::traffic_tcp, nano::stat::detail::all, nano::stat::dir::in, size_a);
-						this_l->set_last_completion ();
-						this_l->set_last_receive_time ();
+						cbk (ec, size_a);
 					}
-					cbk (ec, size_a);
 				}));
 			});
 		}
 	}
 	else
 	{
-		debug_assert (false && "nano::transport::tcp_socket::async_read called with incorrect buffer size");
+		debug_assert (false && "nano::transport::tcp_socket::async_read_some called with incorrect buffer size");
 		boost::system::error_code ec_buffer = boost::system::errc::make_error_code (boost::system::errc::no_buffer_space);
 		callback_a (ec_buffer, 0);
 	}
 }
 
+bool nano::transport::tcp_socket::read_completed (boost::system::error_code const & ec, std::size_t size_a)
+{
+	debug_assert (strand.running_in_this_thread ());
+
+	auto node_l = node_w.lock ();
+	if (!node_l)
+	{
+		return false;
+	}
+
+	if (ec)
+	{
+		node_l->stats.inc (nano::stat::type::tcp, nano::stat::detail::tcp_read_error, nano::stat::dir::in);
+		close ();
+	}
+	else
+	{
+		node_l->stats.add (nano::stat::type::traffic_tcp, nano::stat::detail::all, nano::stat::dir::in, size_a);
+		set_last_completion ();
+		set_last_receive_time ();
+	}
+	return true;
+}
+
 void nano::transport::tcp_socket::async_write (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a, nano::transport::traffic_type traffic_type)
 {
 	auto node_l = node_w.lock ();
@@ -159,6 +214,7 @@ void nano::transport::tcp_socket::async_write (nano::shared_const_buffer const &
 	bool queued = send_queue.insert (buffer_a, callback_a, traffic_type);
 	if (!queued)
 	{
+		node_l->stats.inc (nano::stat::type::tcp, nano::stat::detail::tcp_write_drop, nano::stat::dir::out);
 		if (callback_a)
 		{
 			node_l->background ([callback = std::move (callback_a)] () {
@@ -186,17 +242,41 @@ void nano::transport::tcp_socket::write_queued_messages ()
 		return;
 	}
 
-	auto next = send_queue.pop ();
-	if (!next)
+	auto node_l = node_w.lock ();
+	if (!node_l)
 	{
 		return;
 	}
 
+	// Drain as many queued messages as the limits allow into one gathered write, small messages such as votes would otherwise cost a syscall and a strand round trip each
+	auto batch = std::make_shared<std::vector<socket_queue::entry>> ();
+	std::vector<boost::asio::const_buffer> buffers;
+	std::size_t batch_bytes = 0;
+	while (batch->size () < max_write_batch_count && batch_bytes < max_write_batch_bytes)
+	{
+		auto next = send_queue.pop ();
+		if (!next)
+		{
+			break;
+		}
+		batch_bytes += next->buffer.size ();
+		buffers.push_back (*next->buffer.begin ());
+		batch->push_back (std::move (*next));
+	}
+	if (batch->empty ())
+	{
+		return;
+	}
+
+	// Samplers are shared by all sockets and locked on every sample, only the longest waiting message of the batch is recorded
+	auto const oldest = std::min_element (batch->cbegin (), batch->cend (), [] (auto const & first, auto const & second) { return first.queued < second.queued; });
+	node_l->stats.sample (to_queue_delay_sample (oldest->type), std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - oldest->queued).count (), { 0, 1000 });
+
 	set_default_timeout ();
 
 	write_in_progress = true;
-	nano::async_write (raw_socket, next->buffer,
-	boost::asio::bind_executor (strand, [this_l = shared_from_this (), next /* `next` object keeps buffer in scope */] (boost::system::error_code ec, std::size_t size) {
+	nano::unsafe_async_write (raw_socket, buffers,
+	boost::asio::bind_executor (strand, [this_l = shared_from_this (), batch /* `batch` object keeps buffers in scope */] (boost::system::error_code ec, std::size_t size) {
 		debug_assert (this_l->strand.running_in_this_thread ());
 
 		auto node_l = this_l->node_w.lock ();
@@ -214,12 +294,16 @@ void nano::transport::tcp_socket::write_queued_messages ()
 		else
 		{
 			node_l->stats.add (nano::stat::type::traffic_tcp, nano::stat::detail::all, nano::stat::dir::out, size, /* aggregate all */ true);
+			node_l->stats.add (nano::stat::type::tcp, nano::stat::detail::tcp_write_coalesced, nano::stat::dir::out, batch->size () - 1);
 			this_l->set_last_completion ();
 		}
 
-		if (next->callback)
+		for (auto const & entry : *batch)
 		{
-			next->callback (ec, size);
+			if (entry.callback)
+			{
+				entry.callback (ec, ec ? 0 : entry.buffer.size ());
+			}
 		}
 
 		if (!ec)
@@ -229,14 +313,14 @@ void nano::transport::tcp_socket::write_queued_messages ()
 	}));
 }
 
-bool nano::transport::tcp_socket::max (nano::transport::traffic_type traffic_type) const
+bool nano::transport::tcp_socket::max (nano::transport::traffic_type traffic_type, std::size_t size) const
 {
-	return send_queue.size (traffic_type) >= max_queue_size;
+	return send_queue.max (traffic_type, size);
 }
 
-bool nano::transport::tcp_socket::full (nano::transport::traffic_type traffic_type) const
+bool nano::transport::tcp_socket::full (nano::transport::traffic_type traffic_type, std::size_t size) const
 {
-	return send_queue.size (traffic_type) >= 2 * max_queue_size;
+	return send_queue.full (traffic_type, size);
 }
 
 /** Call set_timeout with default_timeout as parameter */
@@ -344,6 +428,23 @@ void nano::transport::tcp_socket::read_impl (std::shared_ptr<std::vector<uint8_t
 	});
 }
 
+void nano::transport::tcp_socket::read_some_impl (std::shared_ptr<std::vector<uint8_t>> const & data_a, std::size_t offset_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a)
+{
+	auto node_l = node_w.lock ();
+	if (!node_l)
+	{
+		return;
+	}
+
+	// Increase timeout to receive TCP header (idle server socket)
+	auto const prev_timeout = get_default_timeout_value ();
+	set_default_timeout_value (node_l->network_params.network.idle_timeout);
+	async_read_some (data_a, offset_a, size_a, [callback_l = std::move (callback_a), prev_timeout, this_l = shared_from_this ()] (boost::system::error_code const & ec_a, std::size_t size_a) {
+		this_l->set_default_timeout_value (prev_timeout);
+		callback_l (ec_a, size_a);
+	});
+}
+
 bool nano::transport::tcp_socket::has_timed_out () const
 {
 	return timed_out;
@@ -416,21 +517,66 @@ void nano::transport::tcp_socket::operator() (nano::object_stream & obs) const
 	obs.write ("endpoint_type", endpoint_type_m);
 }
 
+nano::stat::sample nano::transport::to_queue_delay_sample (nano::transport::traffic_type type)
+{
+	switch (type)
+	{
+		case nano::transport::traffic_type::generic:
+			return nano::stat::sample::queue_delay_generic;
+		case nano::transport::traffic_type::bootstrap:
+			return nano::stat::sample::queue_delay_bootstrap;
+		case nano::transport::traffic_type::vote:
+			return nano::stat::sample::queue_delay_vote;
+		case nano::transport::traffic_type::vote_final:
+			return nano::stat::sample::queue_delay_vote_final;
+		case nano::transport::traffic_type::block:
+			return nano::stat::sample::queue_delay_block;
+		case nano::transport::traffic_type::telemetry:
+			return nano::stat::sample::queue_delay_telemetry;
+	}
+	debug_assert (false);
+	return {};
+}
+
+/*
+ * socket_queue_config
+ */
+
+nano::transport::socket_queue_config::socket_queue_config ()
+{
+	using nano::transport::traffic_type;
+
+	// Votes are small and latency critical, final votes most of all. Bootstrap responses are large but only need a steady share.
+	quantum[traffic_type::vote_final] = 16 * 1024;
+	quantum[traffic_type::vote] = 8 * 1024;
+	quantum[traffic_type::block] = 4 * 1024;
+	quantum[traffic_type::generic] = 4 * 1024;
+	quantum[traffic_type::bootstrap] = 2 * 1024;
+	quantum[traffic_type::telemetry] = 1024;
+
+	max_bytes.fill (1024 * 1024);
+	max_bytes[traffic_type::bootstrap] = 4 * 1024 * 1024;
+	max_bytes[traffic_type::telemetry] = 256 * 1024;
+}
+
 /*
  * socket_queue
  */
 
-nano::transport::socket_queue::socket_queue (std::size_t max_size_a) :
-	max_size{ max_size_a }
+nano::transport::socket_queue::socket_queue (std::size_t max_size_a, socket_queue_config const & config_a) :
+	max_size{ max_size_a },
+	config{ config_a }
 {
 }
 
 bool nano::transport::socket_queue::insert (const buffer_t & buffer, callback_t callback, nano::transport::traffic_type traffic_type)
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	if (queues[traffic_type].size () < 2 * max_size)
+	if (!exceeds (traffic_type, buffer.size (), 2 * max_size))
 	{
-		queues[traffic_type].push (entry{ buffer, callback });
+		auto & queue = queues[traffic_type];
+		queue.entries.push (entry{ buffer, callback, traffic_type, std::chrono::steady_clock::now () });
+		queue.bytes += buffer.size ();
 		return true; // Queued
 	}
 	return false; // Not queued
@@ -440,54 +586,99 @@ std::optional<nano::transport::socket_queue::entry> nano::transport::socket_queu
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 
-	auto try_pop = [this] (nano::transport::traffic_type type) -> std::optional<entry> {
-		auto & que = queues[type];
-		if (!que.empty ())
-		{
-			auto item = que.front ();
-			que.pop ();
-			return item;
-		}
+	if (std::all_of (queues.begin (), queues.end (), [] (auto const & queue) { return queue.entries.empty (); }))
+	{
 		return std::nullopt;
+	}
+
+	auto const & types = nano::enum_util::values<nano::transport::traffic_type> ();
+	auto next = [this, &types] () {
+		current = (current + 1) % types.size ();
+		credited = false;
 	};
 
-	// TODO: This is a very basic prioritization, implement something more advanced and configurable
-	if (auto item = try_pop (nano::transport::traffic_type::generic))
-	{
-		return item;
-	}
-	if (auto item = try_pop (nano::transport::traffic_type::bootstrap))
+	// Terminates since every round credits each non-empty queue, until one can afford its front message
+	while (true)
 	{
+		auto const type = types[current];
+		auto & queue = queues[type];
+		if (queue.entries.empty ())
+		{
+			queue.deficit = 0;
+			next ();
+			continue;
+		}
+		if (!credited)
+		{
+			queue.deficit += std::max<std::size_t> (config.quantum[type], 1);
+			credited = true;
+		}
+		auto const size = queue.entries.front ().buffer.size ();
+		if (size > queue.deficit)
+		{
+			next ();
+			continue;
+		}
+
+		queue.deficit -= size;
+		queue.bytes -= size;
+		auto item = std::move (queue.entries.front ());
+		queue.entries.pop ();
+		if (queue.entries.empty ())
+		{
+			// Idle queues do not bank credit
+			queue.deficit = 0;
+			next ();
+		}
 		return item;
 	}
-
-	return std::nullopt;
 }
 
 void nano::transport::socket_queue::clear ()
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	queues.clear ();
+	for (auto & queue : queues)
+	{
+		queue = {};
+	}
+	current = 0;
+	credited = false;
 }
 
 std::size_t nano::transport::socket_queue::size (nano::transport::traffic_type traffic_type) const
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	if (auto it = queues.find (traffic_type); it != queues.end ())
-	{
-		return it->second.size ();
-	}
-	return 0;
+	return queues[traffic_type].entries.size ();
 }
 
 bool nano::transport::socket_queue::empty () const
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	return std::all_of (queues.begin (), queues.end (), [] (auto const & que) {
-		return que.second.empty ();
+	return std::all_of (queues.begin (), queues.end (), [] (auto const & queue) {
+		return queue.entries.empty ();
 	});
 }
 
+bool nano::transport::socket_queue::max (nano::transport::traffic_type traffic_type, std::size_t size) const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return exceeds (traffic_type, size, max_size);
+}
+
+bool nano::transport::socket_queue::full (nano::transport::traffic_type traffic_type, std::size_t size) const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return exceeds (traffic_type, size, 2 * max_size);
+}
+
+// Must be called with the mutex held
+bool nano::transport::socket_queue::exceeds (nano::transport::traffic_type traffic_type, std::size_t size, std::size_t max_entries) const
+{
+	auto const & queue = queues[traffic_type];
+	bool const over_budget = !queue.entries.empty () && queue.bytes + size > config.max_bytes[traffic_type];
+	return queue.entries.size () >= max_entries || over_budget;
+}
+
 /*
  * socket_functions
  */
@@ -3,10 +3,13 @@
 #include <nano/boost/asio/ip/tcp.hpp>
 #include <nano/boost/asio/strand.hpp>
 #include <nano/lib/asio.hpp>
+#include <nano/lib/enum_util.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/logging.hpp>
+#include <nano/lib/stats_enums.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/node/transport/common.hpp>
+#include <nano/node/transport/fwd.hpp>
 #include <nano/node/transport/traffic_type.hpp>
 
 #include <chrono>
@@ -29,6 +32,22 @@ class node;
 
 namespace nano::transport
 {
+class socket_queue_config final
+{
+public:
+	socket_queue_config ();
+
+public:
+	/** Bytes each traffic type may send per scheduling round, which is its share of the link while every type has data queued */
+	nano::enum_array<nano::transport::traffic_type, std::size_t> quantum;
+	/** Bytes each traffic type may have queued per socket, a message is always accepted into an empty queue. Unlike the entry limit this is never exceeded, not even for messages that must not be dropped */
+	nano::enum_array<nano::transport::traffic_type, std::size_t> max_bytes;
+};
+
+/**
+ * Outgoing messages of a socket, one queue per traffic type, served by deficit round robin.
+ * Each round a non-empty queue earns its quantum in bytes and sends messages while the earned bytes cover them, so no traffic type can starve another.
+ */
 class socket_queue final
 {
 public:
@@ -39,22 +58,40 @@ public:
 	{
 		buffer_t buffer;
 		callback_t callback;
+		nano::transport::traffic_type type{ nano::transport::traffic_type::generic };
+		std::chrono::steady_clock::time_point queued{};
 	};
 
 public:
-	explicit socket_queue (std::size_t max_size);
+	explicit socket_queue (std::size_t max_size, socket_queue_config const & = {});
 
 	bool insert (buffer_t const &, callback_t, nano::transport::traffic_type);
 	std::optional<entry> pop ();
 	void clear ();
 	std::size_t size (nano::transport::traffic_type) const;
 	bool empty () const;
+	/** Whether a message of `size` bytes, zero when unknown, should be dropped instead of queued. `max` is the limit for droppable messages, `full` the one for messages that must not be dropped */
+	bool max (nano::transport::traffic_type, std::size_t size = 0) const;
+	bool full (nano::transport::traffic_type, std::size_t size = 0) const;
 
 	std::size_t const max_size;
+	socket_queue_config const config;
 
 private:
+	struct class_queue
+	{
+		std::queue<entry> entries;
+		std::size_t bytes{ 0 };
+		std::size_t deficit{ 0 };
+	};
+
+	bool exceeds (nano::transport::traffic_type, std::size_t size, std::size_t max_entries) const;
+
 	mutable nano::mutex mutex;
-	std::unordered_map<nano::transport::traffic_type, std::queue<entry>> queues;
+	nano::enum_array<nano::transport::traffic_type, class_queue> queues;
+	// Traffic type currently being served and whether it already received its quantum this round
+	std::size_t current{ 0 };
+	bool credited{ false };
 };
 
 /** Socket class for tcp clients and newly accepted connections */
@@ -66,6 +103,9 @@ class tcp_socket final : public std::enable_shared_from_this<tcp_socket>
 
 public:
 	static std::size_t constexpr default_max_queue_size = 128;
+	/** Limits for coalescing queued messages into a single gathered write */
+	static std::size_t constexpr max_write_batch_count = 64;
+	static std::size_t constexpr max_write_batch_bytes = 64 * 1024;
 
 public:
 	explicit tcp_socket (nano::node &, nano::transport::socket_endpoint = socket_endpoint::client, std::size_t max_queue_size = default_max_queue_size);
@@ -77,7 +117,8 @@ public:
 	boost::asio::ip::tcp::endpoint remote_endpoint,
 	boost::asio::ip::tcp::endpoint local_endpoint,
 	nano::transport::socket_endpoint = socket_endpoint::server,
-	std::size_t max_queue_size = default_max_queue_size);
+	std::size_t max_queue_size = default_max_queue_size,
+	std::shared_ptr<nano::transport::io_shard> = nullptr);
 
 	~tcp_socket ();
 
@@ -93,6 +134,13 @@ public:
 	std::size_t size,
 	std::function<void (boost::system::error_code const &, std::size_t)> callback);
 
+	/** Reads whatever is available, at most `size` bytes into `buffer` starting at `offset` */
+	void async_read_some (
+	std::shared_ptr<std::vector<uint8_t>> const & buffer,
+	std::size_t offset,
+	std::size_t size,
+	std::function<void (boost::system::error_code const &, std::size_t)> callback);
+
 	void async_write (
 	nano::shared_const_buffer const &,
 	std::function<void (boost::system::error_code const &, std::size_t)> callback = {},
@@ -108,8 +156,8 @@ public:
 	std::chrono::seconds get_default_timeout_value () const;
 	void set_timeout (std::chrono::seconds);
 
-	bool max (nano::transport::traffic_type = traffic_type::generic) const;
-	bool full (nano::transport::traffic_type = traffic_type::generic) const;
+	bool max (nano::transport::traffic_type = traffic_type::generic, std::size_t size = 0) const;
+	bool full (nano::transport::traffic_type = traffic_type::generic, std::size_t size = 0) const;
 
 	nano::transport::socket_type type () const
 	{
@@ -146,6 +194,8 @@ private:
 protected:
 	std::weak_ptr<nano::node> node_w;
 
+	/** Shard whose io_context serves this socket, null when running on the shared io_context. Declared ahead of `raw_socket` so the context outlives it */
+	std::shared_ptr<nano::transport::io_shard> shard;
 	boost::asio::strand<boost::asio::io_context::executor_type> strand;
 	boost::asio::ip::tcp::socket raw_socket;
 
@@ -193,6 +243,9 @@ protected:
 	void set_last_receive_time ();
 	void ongoing_checkup ();
 	void read_impl (std::shared_ptr<std::vector<uint8_t>> const & data_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a);
+	void read_some_impl (std::shared_ptr<std::vector<uint8_t>> const & data_a, std::size_t offset_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a);
+	/** Updates stats and timestamps after a read, returns false if the node is gone */
+	bool read_completed (boost::system::error_code const &, std::size_t);
 
 private:
 	nano::transport::socket_type type_m{ socket_type::undefined };
@@ -205,6 +258,9 @@ public: // Logging
 	virtual void operator() (nano::object_stream &) const;
 };
 
+/** Stats sample recording how long messages of a traffic type waited in send queues */
+nano::stat::sample to_queue_delay_sample (nano::transport::traffic_type);
+
 using address_socket_mmap = std::multimap<boost::asio::ip::address, std::weak_ptr<tcp_socket>>;
 
 namespace socket_functions
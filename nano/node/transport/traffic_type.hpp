@@ -9,6 +9,14 @@ enum class traffic_type
 {
 	generic,
 	/** For bootstrap (asc_pull_ack, asc_pull_req) traffic */
-	bootstrap
+	bootstrap,
+	/** Non-final votes (confirm_ack) */
+	vote,
+	/** Final votes (confirm_ack), the most latency sensitive traffic */
+	vote_final,
+	/** Block publishing */
+	block,
+	/** Telemetry requests and responses */
+	telemetry,
 };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <nano/node/online_reps.hpp>
 #include <nano/node/rep_tiers.hpp>
 #include <nano/node/repcrawler.hpp>
+#include <nano/node/signatures.hpp>
 #include <nano/node/vote_processor.hpp>
 #include <nano/node/vote_router.hpp>
 #include <nano/secure/common.hpp>
@@ -19,7 +20,7 @@ using namespace std::chrono_literals;
  * vote_processor
  */
 
-nano::vote_processor::vote_processor (vote_processor_config const & config_a, nano::vote_router & vote_router, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_flags & flags_a, nano::logger & logger_a, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a, nano::rep_tiers & rep_tiers_a) :
+nano::vote_processor::vote_processor (vote_processor_config const & config_a, nano::vote_router & vote_router, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_flags & flags_a, nano::logger & logger_a, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a, nano::rep_tiers & rep_tiers_a, nano::signature_checker & checker_a) :
 	config{ config_a },
 	vote_router{ vote_router },
 	observers{ observers_a },
@@ -29,7 +30,8 @@ nano::vote_processor::vote_processor (vote_processor_config const & config_a, na
 	rep_crawler{ rep_crawler_a },
 	ledger{ ledger_a },
 	network_params{ network_params_a },
-	rep_tiers{ rep_tiers_a }
+	rep_tiers{ rep_tiers_a },
+	checker{ checker_a }
 {
 	queue.max_size_query = [this] (auto const & origin) {
 		switch (origin.source)
@@ -154,10 +156,21 @@ void nano::vote_processor::run_batch (nano::unique_lock<nano::mutex> & lock)
 
 	lock.unlock ();
 
+	// Verify all signatures of the batch at once, spread over the signature checker threads
+	nano::signature_check_set check;
+	check.reserve (batch.size ());
+	for (auto const & [item, origin] : batch)
+	{
+		auto const & vote = item.first;
+		check.add (vote->account, vote->hash (), vote->signature);
+	}
+	checker.verify (check);
+
+	std::size_t index = 0;
 	for (auto const & [item, origin] : batch)
 	{
 		auto const & [vote, source] = item;
-		vote_blocking (vote, origin.channel, source);
+		vote_blocking (vote, origin.channel, source, check.valid (index++));
 	}
 
 	total_processed += batch.size ();
@@ -172,9 +185,14 @@ void nano::vote_processor::run_batch (nano::unique_lock<nano::mutex> & lock)
 }
 
 nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote> const & vote, std::shared_ptr<nano::transport::channel> const & channel, nano::vote_source source)
+{
+	return vote_blocking (vote, channel, source, !vote->validate ()); // false => valid vote
+}
+
+nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote> const & vote, std::shared_ptr<nano::transport::channel> const & channel, nano::vote_source source, bool const signature_valid)
 {
 	auto result = nano::vote_code::invalid;
-	if (!vote->validate ()) // false => valid vote
+	if (signature_valid)
 	{
 		auto vote_results = vote_router.vote (vote, source);
 
@@ -14,6 +14,11 @@
 #include <thread>
 #include <unordered_set>
 
+namespace nano
+{
+class signature_checker;
+}
+
 namespace nano
 {
 class vote_processor_config final
@@ -34,7 +39,7 @@ public:
 class vote_processor final
 {
 public:
-	vote_processor (vote_processor_config const &, nano::vote_router &, nano::node_observers &, nano::stats &, nano::node_flags &, nano::logger &, nano::online_reps &, nano::rep_crawler &, nano::ledger &, nano::network_params &, nano::rep_tiers &);
+	vote_processor (vote_processor_config const &, nano::vote_router &, nano::node_observers &, nano::stats &, nano::node_flags &, nano::logger &, nano::online_reps &, nano::rep_crawler &, nano::ledger &, nano::network_params &, nano::rep_tiers &, nano::signature_checker &);
 	~vote_processor ();
 
 	void start ();
@@ -65,10 +70,12 @@ private: // Dependencies
 	nano::ledger & ledger;
 	nano::network_params & network_params;
 	nano::rep_tiers & rep_tiers;
+	nano::signature_checker & checker;
 
 private:
 	void run ();
 	void run_batch (nano::unique_lock<nano::mutex> &);
+	nano::vote_code vote_blocking (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, nano::vote_source, bool signature_valid);
 
 private:
 	using entry_t = std::pair<std::shared_ptr<nano::vote>, nano::vote_source>;
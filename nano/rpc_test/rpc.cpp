@@ -3767,6 +3767,11 @@ TEST (rpc, delegators_parameters)
 		delegators5.put ((i->first), (i->second.get<std::string> ("")));
 	}
 	ASSERT_EQ (0, delegators5.size ());
+
+	// Test with "start" equal to the largest possible account, the scan must not wrap around to the first account
+	request.put ("start", nano::account (std::numeric_limits<nano::uint256_t>::max ()).to_account ());
+	auto response6 (wait_response (system, rpc_ctx, request));
+	ASSERT_EQ (0, response6.get_child ("delegators").size ());
 }
 
 TEST (rpc, delegators_count)
@@ -0,0 +1,234 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/secure/block_cache.hpp>
+
+nano::block_cache::block_cache (std::size_t capacity)
+{
+	// A zero capacity disables caching, otherwise every shard holds at least one entry
+	auto const shard_capacity = capacity == 0 ? 0 : std::max<std::size_t> (1, capacity / shard_count);
+	for (auto & shard : shards)
+	{
+		shard.capacity = shard_capacity;
+	}
+}
+
+std::shared_ptr<nano::block> nano::block_cache::get (nano::block_hash const & hash, std::function<bool (nano::block const &)> const & valid)
+{
+	if (!enabled ())
+	{
+		return nullptr;
+	}
+
+	auto & shard = shard_for (hash);
+	std::shared_ptr<nano::block> result;
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		if (auto existing = shard.index.find (hash); existing != shard.index.end ())
+		{
+			auto & entry = shard.entries[existing->second];
+			entry.referenced = true;
+			result = entry.block;
+		}
+	}
+
+	if (result == nullptr)
+	{
+		misses.fetch_add (1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	// Validate without holding the lock, this usually requires a database lookup
+	if (!valid (*result))
+	{
+		stale.fetch_add (1, std::memory_order_relaxed);
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		shard.erase (hash, result);
+		return nullptr;
+	}
+
+	hits.fetch_add (1, std::memory_order_relaxed);
+	return result;
+}
+
+void nano::block_cache::put (std::shared_ptr<nano::block> const & block, std::optional<uint64_t> generation)
+{
+	debug_assert (block != nullptr);
+	if (!enabled ())
+	{
+		return;
+	}
+
+	// Computes and caches the hash before the block is shared between threads
+	auto const & hash = block->hash ();
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> guard{ shard.mutex };
+	if (generation && shard.invalidated_since (hash, generation.value ()))
+	{
+		dropped.fetch_add (1, std::memory_order_relaxed);
+		return;
+	}
+	shard.put (hash, block);
+}
+
+void nano::block_cache::erase (nano::block_hash const & hash)
+{
+	if (!enabled ())
+	{
+		return;
+	}
+
+	auto const generation = generation_m.fetch_add (1, std::memory_order_acq_rel) + 1;
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> guard{ shard.mutex };
+	shard.erase (hash);
+	shard.invalidate (hash, generation);
+}
+
+void nano::block_cache::clear ()
+{
+	auto const generation = generation_m.fetch_add (1, std::memory_order_acq_rel) + 1;
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		shard.entries.clear ();
+		shard.index.clear ();
+		shard.hand = 0;
+		shard.invalidations.clear ();
+		shard.invalidations_order.clear ();
+		shard.invalidations_floor = generation;
+	}
+}
+
+uint64_t nano::block_cache::generation () const
+{
+	return generation_m.load (std::memory_order_acquire);
+}
+
+std::size_t nano::block_cache::size () const
+{
+	std::size_t result = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		result += shard.entries.size ();
+	}
+	return result;
+}
+
+bool nano::block_cache::enabled () const
+{
+	return shards.front ().capacity > 0;
+}
+
+auto nano::block_cache::shard_for (nano::block_hash const & hash) -> shard &
+{
+	// Block hashes are uniformly distributed, any part of them is a good shard index
+	return shards[hash.qwords[0] % shard_count];
+}
+
+std::unique_ptr<nano::container_info_component> nano::block_cache::collect_container_info (std::string const & name) const
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", size (), sizeof (entry) + sizeof (nano::state_block) + sizeof (nano::block_sideband) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "hits", hits.load (std::memory_order_relaxed), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "misses", misses.load (std::memory_order_relaxed), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "stale", stale.load (std::memory_order_relaxed), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "dropped", dropped.load (std::memory_order_relaxed), 0 }));
+	return composite;
+}
+
+/*
+ * block_cache::shard
+ */
+
+void nano::block_cache::shard::put (nano::block_hash const & hash, std::shared_ptr<nano::block> const & block)
+{
+	debug_assert (!mutex.try_lock ());
+	debug_assert (capacity > 0);
+
+	if (auto existing = index.find (hash); existing != index.end ())
+	{
+		entries[existing->second].block = block;
+		return;
+	}
+
+	if (entries.size () < capacity)
+	{
+		index.emplace (hash, entries.size ());
+		entries.push_back ({ hash, block, false });
+		return;
+	}
+
+	// Advance the clock hand past recently referenced entries, clearing their reference bit on the way
+	while (entries[hand].referenced)
+	{
+		entries[hand].referenced = false;
+		hand = (hand + 1) % entries.size ();
+	}
+	index.erase (entries[hand].hash);
+	entries[hand] = { hash, block, false };
+	index.emplace (hash, hand);
+	hand = (hand + 1) % entries.size ();
+}
+
+void nano::block_cache::shard::erase (nano::block_hash const & hash, std::shared_ptr<nano::block> const & block)
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto existing = index.find (hash);
+	if (existing == index.end ())
+	{
+		return;
+	}
+	auto const position = existing->second;
+	// Only remove the given block, it might have been replaced by a fresh copy in the meantime
+	if (block != nullptr && entries[position].block != block)
+	{
+		return;
+	}
+
+	// Keep entries contiguous by moving the last entry into the freed slot
+	index.erase (existing);
+	if (position != entries.size () - 1)
+	{
+		entries[position] = std::move (entries.back ());
+		index[entries[position].hash] = position;
+	}
+	entries.pop_back ();
+	if (hand >= entries.size ())
+	{
+		hand = 0;
+	}
+}
+
+void nano::block_cache::shard::invalidate (nano::block_hash const & hash, uint64_t generation)
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto & latest = invalidations[hash];
+	latest = std::max (latest, generation);
+	invalidations_order.emplace_back (hash, generation);
+	while (invalidations_order.size () > std::max<std::size_t> (capacity, 1))
+	{
+		auto const [oldest_hash, oldest_generation] = invalidations_order.front ();
+		invalidations_order.pop_front ();
+		// The hash may have been invalidated again later, only forget it once its latest invalidation leaves
+		if (auto existing = invalidations.find (oldest_hash); existing != invalidations.end () && existing->second == oldest_generation)
+		{
+			invalidations.erase (existing);
+		}
+		invalidations_floor = std::max (invalidations_floor, oldest_generation);
+	}
+}
+
+bool nano::block_cache::shard::invalidated_since (nano::block_hash const & hash, uint64_t generation) const
+{
+	debug_assert (!mutex.try_lock ());
+
+	if (generation < invalidations_floor)
+	{
+		return true;
+	}
+	auto existing = invalidations.find (hash);
+	return existing != invalidations.end () && existing->second > generation;
+}
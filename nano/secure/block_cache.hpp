@@ -0,0 +1,90 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace nano
+{
+class block;
+class container_info_component;
+}
+
+namespace nano
+{
+/**
+ * Size bounded cache of deserialized blocks keyed by hash.
+ * Split into independently locked shards. Eviction uses the CLOCK approximation of LRU so lookups only need to set a reference bit.
+ * Every invalidation advances a generation counter. A block read from a snapshot older than a later invalidation of its hash is not inserted, as it could restore an outdated copy.
+ */
+class block_cache final
+{
+public:
+	explicit block_cache (std::size_t capacity = default_capacity);
+
+	/** Returns the cached block if it exists and `valid` accepts it. Entries rejected by `valid` are removed */
+	std::shared_ptr<nano::block> get (nano::block_hash const &, std::function<bool (nano::block const &)> const & valid);
+	/** Inserts a block read from a snapshot at least as new as `generation`, empty if the snapshot is known to be current */
+	void put (std::shared_ptr<nano::block> const &, std::optional<uint64_t> generation = std::nullopt);
+	/** Invalidates the cached block, blocks with this hash read from older snapshots are no longer inserted */
+	void erase (nano::block_hash const &);
+	void clear ();
+	/** Current generation, to be taken before a snapshot is opened */
+	uint64_t generation () const;
+	std::size_t size () const;
+	bool enabled () const;
+
+	std::unique_ptr<container_info_component> collect_container_info (std::string const & name) const;
+
+public:
+	static std::size_t constexpr default_capacity = 64 * 1024;
+	static std::size_t constexpr shard_count = 16;
+
+private:
+	class entry final
+	{
+	public:
+		nano::block_hash hash;
+		std::shared_ptr<nano::block> block;
+		bool referenced;
+	};
+
+	class shard final
+	{
+	public:
+		void put (nano::block_hash const &, std::shared_ptr<nano::block> const &);
+		void erase (nano::block_hash const &, std::shared_ptr<nano::block> const & block = nullptr);
+		void invalidate (nano::block_hash const &, uint64_t generation);
+		bool invalidated_since (nano::block_hash const &, uint64_t generation) const;
+
+		std::vector<entry> entries;
+		std::unordered_map<nano::block_hash, std::size_t> index;
+		std::size_t hand{ 0 };
+		std::size_t capacity{ 0 };
+		// Generation of the latest invalidation of recently invalidated hashes, bounded by `capacity`
+		std::unordered_map<nano::block_hash, uint64_t> invalidations;
+		std::deque<std::pair<nano::block_hash, uint64_t>> invalidations_order;
+		// Latest generation no longer tracked per hash, inserts from older snapshots are dropped whatever their hash
+		uint64_t invalidations_floor{ 0 };
+		mutable nano::mutex mutex{ mutex_identifier (mutexes::blockstore_cache) };
+	};
+
+	shard & shard_for (nano::block_hash const &);
+
+	std::array<shard, shard_count> shards;
+
+	std::atomic<uint64_t> generation_m{ 0 };
+	std::atomic<uint64_t> hits{ 0 };
+	std::atomic<uint64_t> misses{ 0 };
+	std::atomic<uint64_t> stale{ 0 };
+	std::atomic<uint64_t> dropped{ 0 };
+};
+}
@@ -212,6 +212,14 @@ enum class block_status
 std::string_view to_string (block_status);
 nano::stat::detail to_stat_detail (block_status);
 
+/** Outcome of a signature check done ahead of ledger processing */
+enum class signature_verification
+{
+	unknown, // Not checked, the ledger must verify the signature itself
+	valid, // Signed by the account field of the block
+	valid_epoch, // Signed by the epoch signer of the block's epoch link
+};
+
 enum class tally_result
 {
 	vote,
@@ -9,6 +9,7 @@
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/secure/ledger_set_confirmed.hpp>
+#include <nano/secure/parallel_traversal.hpp>
 #include <nano/secure/rep_weights.hpp>
 #include <nano/store/account.hpp>
 #include <nano/store/block.hpp>
@@ -22,6 +23,8 @@
 #include <nano/store/rep_weight.hpp>
 #include <nano/store/version.hpp>
 
+#include <map>
+#include <set>
 #include <stack>
 
 #include <cryptopp/words.h>
@@ -184,7 +187,7 @@ public:
 class ledger_processor : public nano::mutable_block_visitor
 {
 public:
-	ledger_processor (nano::ledger &, nano::secure::write_transaction const &);
+	ledger_processor (nano::ledger &, nano::secure::write_transaction const &, nano::signature_verification = nano::signature_verification::unknown);
 	virtual ~ledger_processor () = default;
 	void send_block (nano::send_block &) override;
 	void receive_block (nano::receive_block &) override;
@@ -195,12 +198,25 @@ public:
 	void epoch_block_impl (nano::state_block &);
 	nano::ledger & ledger;
 	nano::secure::write_transaction const & transaction;
+	nano::signature_verification const verification;
 	nano::block_status result;
 
 private:
 	bool validate_epoch_block (nano::state_block const & block_a);
+	// Returns true if the signature is invalid, skips the check if the block was already verified by `signer`
+	bool validate_signature (nano::account const & account, nano::block_hash const & hash, nano::signature const & signature, nano::signature_verification signer = nano::signature_verification::valid) const;
 };
 
+bool ledger_processor::validate_signature (nano::account const & account, nano::block_hash const & hash, nano::signature const & signature, nano::signature_verification signer) const
+{
+	if (verification == signer)
+	{
+		debug_assert (!validate_message (account, hash, signature));
+		return false;
+	}
+	return validate_message (account, hash, signature);
+}
+
 // Returns true if this block which has an epoch link is correctly formed.
 bool ledger_processor::validate_epoch_block (nano::state_block const & block_a)
 {
@@ -216,10 +232,10 @@ bool ledger_processor::validate_epoch_block (nano::state_block const & block_a)
 		else
 		{
 			// Check for possible regular state blocks with epoch link (send subtype)
-			if (validate_message (block_a.hashables.account, block_a.hash (), block_a.signature))
+			if (validate_signature (block_a.hashables.account, block_a.hash (), block_a.signature))
 			{
 				// Is epoch block signed correctly
-				if (validate_message (ledger.epoch_signer (block_a.link_field ().value ()), block_a.hash (), block_a.signature))
+				if (validate_signature (ledger.epoch_signer (block_a.link_field ().value ()), block_a.hash (), block_a.signature, nano::signature_verification::valid_epoch))
 				{
 					result = nano::block_status::bad_signature;
 				}
@@ -259,7 +275,7 @@ void ledger_processor::state_block_impl (nano::state_block & block_a)
 	result = existing ? nano::block_status::old : nano::block_status::progress; // Have we seen this block before? (Unambiguous)
 	if (result == nano::block_status::progress)
 	{
-		result = validate_message (block_a.hashables.account, hash, block_a.signature) ? nano::block_status::bad_signature : nano::block_status::progress; // Is this block signed correctly (Unambiguous)
+		result = validate_signature (block_a.hashables.account, hash, block_a.signature) ? nano::block_status::bad_signature : nano::block_status::progress; // Is this block signed correctly (Unambiguous)
 		if (result == nano::block_status::progress)
 		{
 			debug_assert (!validate_message (block_a.hashables.account, hash, block_a.signature));
@@ -375,7 +391,7 @@ void ledger_processor::epoch_block_impl (nano::state_block & block_a)
 	result = existing ? nano::block_status::old : nano::block_status::progress; // Have we seen this block before? (Unambiguous)
 	if (result == nano::block_status::progress)
 	{
-		result = validate_message (ledger.epoch_signer (block_a.hashables.link), hash, block_a.signature) ? nano::block_status::bad_signature : nano::block_status::progress; // Is this block signed correctly (Unambiguous)
+		result = validate_signature (ledger.epoch_signer (block_a.hashables.link), hash, block_a.signature, nano::signature_verification::valid_epoch) ? nano::block_status::bad_signature : nano::block_status::progress; // Is this block signed correctly (Unambiguous)
 		if (result == nano::block_status::progress)
 		{
 			debug_assert (!validate_message (ledger.epoch_signer (block_a.hashables.link), hash, block_a.signature));
@@ -443,7 +459,7 @@ void ledger_processor::change_block (nano::change_block & block_a)
 	result = existing ? nano::block_status::old : nano::block_status::progress; // Have we seen this block before? (Harmless)
 	if (result == nano::block_status::progress)
 	{
-		auto previous (ledger.store.block.get (transaction, block_a.hashables.previous));
+		auto previous (ledger.any.block_get (transaction, block_a.hashables.previous));
 		result = previous != nullptr ? nano::block_status::progress : nano::block_status::gap_previous; // Have we seen the previous block already? (Harmless)
 		if (result == nano::block_status::progress)
 		{
@@ -487,7 +503,7 @@ void ledger_processor::send_block (nano::send_block & block_a)
 	result = existing ? nano::block_status::old : nano::block_status::progress; // Have we seen this block before? (Harmless)
 	if (result == nano::block_status::progress)
 	{
-		auto previous (ledger.store.block.get (transaction, block_a.hashables.previous));
+		auto previous (ledger.any.block_get (transaction, block_a.hashables.previous));
 		result = previous != nullptr ? nano::block_status::progress : nano::block_status::gap_previous; // Have we seen the previous block already? (Harmless)
 		if (result == nano::block_status::progress)
 		{
@@ -536,7 +552,7 @@ void ledger_processor::receive_block (nano::receive_block & block_a)
 	result = existing ? nano::block_status::old : nano::block_status::progress; // Have we seen this block already?  (Harmless)
 	if (result == nano::block_status::progress)
 	{
-		auto previous (ledger.store.block.get (transaction, block_a.hashables.previous));
+		auto previous (ledger.any.block_get (transaction, block_a.hashables.previous));
 		result = previous != nullptr ? nano::block_status::progress : nano::block_status::gap_previous;
 		if (result == nano::block_status::progress)
 		{
@@ -598,7 +614,7 @@ void ledger_processor::open_block (nano::open_block & block_a)
 	result = existing ? nano::block_status::old : nano::block_status::progress; // Have we seen this block already? (Harmless)
 	if (result == nano::block_status::progress)
 	{
-		result = validate_message (block_a.hashables.account, hash, block_a.signature) ? nano::block_status::bad_signature : nano::block_status::progress; // Is the signature valid (Malformed)
+		result = validate_signature (block_a.hashables.account, hash, block_a.signature) ? nano::block_status::bad_signature : nano::block_status::progress; // Is the signature valid (Malformed)
 		if (result == nano::block_status::progress)
 		{
 			debug_assert (!validate_message (block_a.hashables.account, hash, block_a.signature));
@@ -641,9 +657,10 @@ void ledger_processor::open_block (nano::open_block & block_a)
 	}
 }
 
-ledger_processor::ledger_processor (nano::ledger & ledger_a, nano::secure::write_transaction const & transaction_a) :
+ledger_processor::ledger_processor (nano::ledger & ledger_a, nano::secure::write_transaction const & transaction_a, nano::signature_verification verification_a) :
 	ledger (ledger_a),
-	transaction (transaction_a)
+	transaction (transaction_a),
+	verification (verification_a)
 {
 }
 
@@ -711,16 +728,19 @@ void representative_visitor::state_block (nano::state_block const & block_a)
 }
 } // namespace
 
-nano::ledger::ledger (nano::store::component & store_a, nano::stats & stat_a, nano::ledger_constants & constants, nano::generate_cache_flags const & generate_cache_flags_a, nano::uint128_t min_rep_weight_a) :
+nano::ledger::ledger (nano::store::component & store_a, nano::stats & stat_a, nano::ledger_constants & constants, nano::generate_cache_flags const & generate_cache_flags_a, nano::uint128_t min_rep_weight_a, std::size_t block_cache_size) :
 	constants{ constants },
 	store{ store_a },
 	cache{ store_a.rep_weight, min_rep_weight_a },
 	stats{ stat_a },
 	check_bootstrap_weights{ true },
+	generate_cache{ generate_cache_flags_a },
 	any_impl{ std::make_unique<ledger_set_any> (*this) },
 	confirmed_impl{ std::make_unique<ledger_set_confirmed> (*this) },
+	block_cache_impl{ std::make_unique<nano::block_cache> (block_cache_size) },
 	any{ *any_impl },
-	confirmed{ *confirmed_impl }
+	confirmed{ *confirmed_impl },
+	block_cache{ *block_cache_impl }
 {
 	if (!store.init_error ())
 	{
@@ -734,62 +754,190 @@ nano::ledger::~ledger ()
 
 auto nano::ledger::tx_begin_write (std::vector<nano::tables> const & tables_to_lock, nano::store::writer guard_type) const -> secure::write_transaction
 {
-	auto guard = store.write_queue.wait (guard_type);
-	auto txn = store.tx_begin_write (tables_to_lock);
+	auto guard = store.write_queue.wait (guard_type, tables_to_lock);
+	// Persisted ledger counters live in the meta table. Each writer updates its own keys, so meta is accessible without being locked
+	auto txn = tables_to_lock.empty () ? store.tx_begin_write () : store.tx_begin_write (tables_to_lock, { tables::meta });
 	return secure::write_transaction{ std::move (txn), std::move (guard) };
 }
 
 auto nano::ledger::tx_begin_read () const -> secure::read_transaction
 {
-	return secure::read_transaction{ store.tx_begin_read () };
+	// Taken ahead of the snapshot so blocks invalidated while it is being opened are not cached from it
+	auto const generation = block_cache.generation ();
+	return secure::read_transaction{ store.tx_begin_read (), &block_cache, generation };
 }
 
 void nano::ledger::initialize (nano::generate_cache_flags const & generate_cache_flags_a)
 {
-	if (generate_cache_flags_a.reps || generate_cache_flags_a.account_count || generate_cache_flags_a.block_count)
+	auto transaction (store.tx_begin_read ());
+
+	// Counters persisted by earlier runs spare the full table scans, they are missing on first start after an upgrade or when invalidated
+	auto const persisted_block_count = store.version.counter_get (transaction, nano::store::counter::block_count);
+	auto const persisted_account_count = store.version.counter_get (transaction, nano::store::counter::account_count);
+	auto const persisted_cemented_count = store.version.counter_get (transaction, nano::store::counter::cemented_count);
+
+	if ((generate_cache_flags_a.block_count && !persisted_block_count) || (generate_cache_flags_a.account_count && !persisted_account_count))
 	{
-		store.account.for_each_par (
-		[this] (store::read_transaction const & /*unused*/, store::iterator<nano::account, nano::account_info> i, store::iterator<nano::account, nano::account_info> n) {
+		parallel_traversal<nano::uint256_t> (
+		[this] (nano::uint256_t const & start, nano::uint256_t const & end, bool const is_last) {
 			uint64_t block_count_l{ 0 };
 			uint64_t account_count_l{ 0 };
-			for (; i != n; ++i)
-			{
-				nano::account_info const & info (i->second);
+			this->store.account.for_each_range (this->store.tx_begin_read (), start, !is_last ? end : 0, [&] (nano::account const &, nano::account_info const & info) {
 				block_count_l += info.block_count;
 				++account_count_l;
-			}
+				return true;
+			});
 			this->cache.block_count += block_count_l;
 			this->cache.account_count += account_count_l;
 		});
+	}
+	else
+	{
+		cache.block_count = persisted_block_count.value_or (0);
+		cache.account_count = persisted_account_count.value_or (0);
+	}
 
-		store.rep_weight.for_each_par (
-		[this] (store::read_transaction const & /*unused*/, store::iterator<nano::account, nano::uint128_union> i, store::iterator<nano::account, nano::uint128_union> n) {
+	if (generate_cache_flags_a.reps)
+	{
+		parallel_traversal<nano::uint256_t> (
+		[this] (nano::uint256_t const & start, nano::uint256_t const & end, bool const is_last) {
 			nano::rep_weights rep_weights_l{ this->store.rep_weight };
-			for (; i != n; ++i)
-			{
-				rep_weights_l.representation_put (i->first, i->second.number ());
-			}
+			this->store.rep_weight.for_each_range (this->store.tx_begin_read (), start, !is_last ? end : 0, [&rep_weights_l] (nano::account const & representative, nano::uint128_union const & weight) {
+				rep_weights_l.representation_put (representative, weight.number ());
+				return true;
+			});
 			this->cache.rep_weights.copy_from (rep_weights_l);
 		});
 	}
 
 	if (generate_cache_flags_a.cemented_count)
 	{
-		store.confirmation_height.for_each_par (
-		[this] (store::read_transaction const & /*unused*/, store::iterator<nano::account, nano::confirmation_height_info> i, store::iterator<nano::account, nano::confirmation_height_info> n) {
-			uint64_t cemented_count_l (0);
-			for (; i != n; ++i)
-			{
-				cemented_count_l += i->second.height;
-			}
-			this->cache.cemented_count += cemented_count_l;
-		});
+		if (persisted_cemented_count)
+		{
+			cache.cemented_count = *persisted_cemented_count;
+		}
+		else
+		{
+			parallel_traversal<nano::uint256_t> (
+			[this] (nano::uint256_t const & start, nano::uint256_t const & end, bool const is_last) {
+				uint64_t cemented_count_l (0);
+				this->store.confirmation_height.for_each_range (this->store.tx_begin_read (), start, !is_last ? end : 0, [&cemented_count_l] (nano::account const &, nano::confirmation_height_info const & info) {
+					cemented_count_l += info.height;
+					return true;
+				});
+				this->cache.cemented_count += cemented_count_l;
+			});
+		}
 	}
 
-	auto transaction (store.tx_begin_read ());
 	cache.pruned_count = store.pruned.count (transaction);
 }
 
+bool nano::ledger::tracked (nano::store::counter counter) const
+{
+	switch (counter)
+	{
+		case nano::store::counter::block_count:
+			return generate_cache.block_count;
+		case nano::store::counter::account_count:
+			return generate_cache.account_count;
+		case nano::store::counter::cemented_count:
+			return generate_cache.cemented_count;
+	}
+	debug_assert (false);
+	return false;
+}
+
+void nano::ledger::persist_counter (secure::write_transaction const & transaction, nano::store::counter counter, uint64_t value)
+{
+	if (tracked (counter))
+	{
+		store.version.counter_put (transaction, counter, value);
+	}
+	else
+	{
+		// The in-memory value is not a full count, make the next start recount instead of trusting a stale value
+		store.version.counter_del (transaction, counter);
+	}
+}
+
+void nano::ledger::persist_block_counts (secure::write_transaction const & transaction)
+{
+	persist_counter (transaction, nano::store::counter::block_count, cache.block_count);
+	persist_counter (transaction, nano::store::counter::account_count, cache.account_count);
+}
+
+void nano::ledger::persist_cemented_count (secure::write_transaction const & transaction)
+{
+	persist_counter (transaction, nano::store::counter::cemented_count, cache.cemented_count);
+}
+
+bool nano::ledger::verify_counts (std::function<bool ()> const & cancelled)
+{
+	if (!tracked (nano::store::counter::block_count) || !tracked (nano::store::counter::account_count) || !tracked (nano::store::counter::cemented_count))
+	{
+		return false;
+	}
+
+	// Persisted values and the recount have to describe the same ledger state, so everything is read from one snapshot
+	auto transaction (store.tx_begin_read ());
+	std::array<std::optional<uint64_t>, 3> const persisted{
+		store.version.counter_get (transaction, nano::store::counter::block_count),
+		store.version.counter_get (transaction, nano::store::counter::account_count),
+		store.version.counter_get (transaction, nano::store::counter::cemented_count)
+	};
+	std::array<uint64_t, 3> recounted{ 0, 0, 0 };
+
+	uint64_t iterations{ 0 };
+	bool stopped{ false };
+	auto proceed = [&] () {
+		stopped = stopped || (++iterations % 4096 == 0 && cancelled ());
+		return !stopped;
+	};
+	store.account.for_each_range (transaction, 0, 0, [&] (nano::account const &, nano::account_info const & info) {
+		recounted[0] += info.block_count;
+		++recounted[1];
+		return proceed ();
+	});
+	store.confirmation_height.for_each_range (transaction, 0, 0, [&] (nano::account const &, nano::confirmation_height_info const & info) {
+		recounted[2] += info.height;
+		return proceed ();
+	});
+	if (stopped)
+	{
+		return false;
+	}
+
+	if (persisted[0] == recounted[0] && persisted[1] == recounted[1] && persisted[2] == recounted[2])
+	{
+		return false;
+	}
+
+	// Writers may have moved the counters since the snapshot, only the drift observed at the snapshot is applied
+	// Writers update the counters in meta without locking it, under the tables they count. Locking those tables too keeps this write
+	// from running concurrently with them, which on backends locking per table would otherwise conflict on the counter keys
+	auto write_transaction = tx_begin_write ({ tables::accounts, tables::confirmation_height, tables::meta });
+	std::array<std::pair<nano::store::counter, std::atomic<uint64_t> *>, 3> const counters{ {
+	{ nano::store::counter::block_count, &cache.block_count },
+	{ nano::store::counter::account_count, &cache.account_count },
+	{ nano::store::counter::cemented_count, &cache.cemented_count },
+	} };
+	for (std::size_t index = 0; index < counters.size (); ++index)
+	{
+		auto const & [counter, value] = counters[index];
+		if (persisted[index] != recounted[index])
+		{
+			stats.inc (nano::stat::type::ledger, nano::stat::detail::counter_corrected);
+			if (persisted[index])
+			{
+				*value += recounted[index] - *persisted[index];
+			}
+			store.version.counter_put (write_transaction, counter, *value);
+		}
+	}
+	return true;
+}
+
 nano::uint128_t nano::ledger::account_receivable (secure::transaction const & transaction_a, nano::account const & account_a, bool only_confirmed_a)
 {
 	nano::uint128_t result{ 0 };
@@ -807,55 +955,217 @@ nano::uint128_t nano::ledger::account_receivable (secure::transaction const & tr
 std::deque<std::shared_ptr<nano::block>> nano::ledger::confirm (secure::write_transaction const & transaction, nano::block_hash const & hash)
 {
 	std::deque<std::shared_ptr<nano::block>> result;
+	confirm (transaction, hash, std::numeric_limits<std::size_t>::max (), [&result] (std::deque<std::shared_ptr<nano::block>> & blocks) {
+		std::move (blocks.begin (), blocks.end (), std::back_inserter (result));
+	});
+	return result;
+}
+
+void nano::ledger::confirm (secure::write_transaction const & transaction, nano::block_hash const & hash, std::size_t max_chunk, std::function<void (std::deque<std::shared_ptr<nano::block>> &)> const & callback)
+{
+	debug_assert (max_chunk > 0);
+
+	// Confirmation heights cemented in the current chunk but not yet written
+	std::unordered_map<nano::account, nano::confirmation_height_info> heights;
+	std::deque<std::shared_ptr<nano::block>> chunk;
+
+	auto flush = [&] () {
+		for (auto const & [account, info] : heights)
+		{
+			store.confirmation_height.put (transaction, account, info);
+		}
+		heights.clear ();
+		persist_cemented_count (transaction);
+		callback (chunk);
+		chunk.clear ();
+	};
+
+	confirm_walk (transaction, hash, heights, [&] (std::shared_ptr<nano::block> const & block) {
+		++cache.cemented_count;
+		stats.inc (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed);
+		chunk.push_back (block);
+		if (chunk.size () >= max_chunk)
+		{
+			flush ();
+		}
+		return true;
+	});
+	if (!chunk.empty ())
+	{
+		flush ();
+	}
+}
+
+std::deque<std::shared_ptr<nano::block>> nano::ledger::confirm_resolve (secure::transaction const & transaction, nano::block_hash const & hash, std::size_t max_blocks) const
+{
+	std::unordered_map<nano::account, nano::confirmation_height_info> heights;
+	std::deque<std::shared_ptr<nano::block>> result;
+	if (max_blocks > 0)
+	{
+		confirm_walk (transaction, hash, heights, [&] (std::shared_ptr<nano::block> const & block) {
+			result.push_back (block);
+			return result.size () < max_blocks;
+		});
+	}
+	return result;
+}
+
+bool nano::ledger::confirm_resolved (secure::write_transaction const & transaction, std::deque<std::shared_ptr<nano::block>> const & resolved, std::size_t max_chunk, std::function<void (std::deque<std::shared_ptr<nano::block>> &)> const & callback)
+{
+	debug_assert (max_chunk > 0);
+
+	// Replay the resolved blocks on top of the current confirmation heights, each one has to extend its account's cemented frontier
+	std::unordered_map<nano::account, nano::confirmation_height_info> heights;
+	std::unordered_map<nano::account, nano::block_hash> tops;
+	std::deque<std::shared_ptr<nano::block>> blocks;
+	for (auto const & block : resolved)
+	{
+		auto const account = block->account ();
+		auto existing = heights.find (account);
+		if (existing == heights.end ())
+		{
+			existing = heights.emplace (account, store.confirmation_height.get (transaction, account).value_or (nano::confirmation_height_info{})).first;
+		}
+		auto & current = existing->second;
+		auto const height = block->sideband ().height;
+		if (height <= current.height)
+		{
+			// Cemented since resolving
+			if (height == current.height && block->hash () != current.frontier)
+			{
+				return true;
+			}
+			continue;
+		}
+		if (height != current.height + 1 || block->previous () != current.frontier)
+		{
+			return true;
+		}
+		current = { height, block->hash () };
+		tops[account] = block->hash ();
+		blocks.push_back (block);
+	}
+
+	// Rollbacks remove blocks from the top of account chains, so if the highest resolved block of each account exists all of them do
+	for (auto const & [account, hash] : tops)
+	{
+		if (!store.block.exists (transaction, hash))
+		{
+			return true;
+		}
+	}
+
+	heights.clear ();
+	std::deque<std::shared_ptr<nano::block>> chunk;
+	auto flush = [&] () {
+		for (auto const & [account, info] : heights)
+		{
+			store.confirmation_height.put (transaction, account, info);
+		}
+		heights.clear ();
+		persist_cemented_count (transaction);
+		callback (chunk);
+		chunk.clear ();
+	};
+
+	for (auto const & block : blocks)
+	{
+		++cache.cemented_count;
+		stats.inc (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed);
+		heights[block->account ()] = { block->sideband ().height, block->hash () };
+		chunk.push_back (block);
+		if (chunk.size () >= max_chunk)
+		{
+			flush ();
+		}
+	}
+	if (!chunk.empty ())
+	{
+		flush ();
+	}
+	return false;
+}
+
+void nano::ledger::confirm_walk (secure::transaction const & transaction, nano::block_hash const & hash, std::unordered_map<nano::account, nano::confirmation_height_info> & heights, std::function<bool (std::shared_ptr<nano::block> const &)> const & visitor) const
+{
+	auto height_get = [&] (nano::account const & account) {
+		auto existing = heights.find (account);
+		if (existing != heights.end ())
+		{
+			return existing->second;
+		}
+		return store.confirmation_height.get (transaction, account).value_or (nano::confirmation_height_info{});
+	};
+	auto is_confirmed = [&] (nano::block_hash const & hash) {
+		if (store.pruned.exists (transaction, hash))
+		{
+			return true;
+		}
+		auto block = any.block_get (transaction, hash);
+		return block && block->sideband ().height <= height_get (block->account ()).height;
+	};
+
+	// Each account chain is walked upwards from its confirmation frontier instead of downwards from the target.
+	// The stack then grows with the number of chained account dependencies instead of with the chain length.
 	std::stack<nano::block_hash> stack;
 	stack.push (hash);
 	while (!stack.empty ())
 	{
-		auto hash = stack.top ();
-		auto block = any.block_get (transaction, hash);
+		auto target = any.block_get (transaction, stack.top ());
+		release_assert (target);
+		auto const account = target->account ();
+		auto const info = height_get (account);
+		if (target->sideband ().height <= info.height)
+		{
+			stack.pop ();
+			continue;
+		}
+
+		auto next_hash = info.height == 0 ? any.account_get (transaction, account).value ().open_block : any.block_successor (transaction, info.frontier).value ();
+		auto block = next_hash == target->hash () ? target : any.block_get (transaction, next_hash);
 		release_assert (block);
-		auto dependents = dependent_blocks (transaction, *block);
-		for (auto const & dependent : dependents)
+
+		bool dependencies_pending = false;
+		for (auto const & dependent : dependent_blocks (transaction, *block))
 		{
-			if (!dependent.is_zero () && !confirmed.block_exists_or_pruned (transaction, dependent))
+			if (!dependent.is_zero () && !is_confirmed (dependent))
 			{
 				stack.push (dependent);
+				dependencies_pending = true;
 			}
 		}
-		if (stack.top () == hash)
+		if (dependencies_pending)
 		{
-			stack.pop ();
-			if (!confirmed.block_exists_or_pruned (transaction, hash))
-			{
-				result.push_back (block);
-				confirm (transaction, *block);
-			}
+			continue;
 		}
-		else
+
+		debug_assert (info.height + 1 == block->sideband ().height);
+		heights[account] = { block->sideband ().height, block->hash () };
+		if (!visitor (block))
 		{
-			// unconfirmed dependencies were added
+			break;
 		}
 	}
-	return result;
 }
 
-void nano::ledger::confirm (secure::write_transaction const & transaction, nano::block const & block)
+nano::block_status nano::ledger::process (secure::write_transaction const & transaction_a, std::shared_ptr<nano::block> block_a)
 {
-	debug_assert ((!store.confirmation_height.get (transaction, block.account ()) && block.sideband ().height == 1) || store.confirmation_height.get (transaction, block.account ()).value ().height + 1 == block.sideband ().height);
-	confirmation_height_info info{ block.sideband ().height, block.hash () };
-	store.confirmation_height.put (transaction, block.account (), info);
-	++cache.cemented_count;
-	stats.inc (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed);
+	return process (transaction_a, block_a, nano::signature_verification::unknown);
 }
 
-nano::block_status nano::ledger::process (secure::write_transaction const & transaction_a, std::shared_ptr<nano::block> block_a)
+nano::block_status nano::ledger::process (secure::write_transaction const & transaction_a, std::shared_ptr<nano::block> block_a, nano::signature_verification verification_a)
 {
 	debug_assert (!constants.work.validate_entry (*block_a) || constants.genesis == nano::dev::genesis);
-	ledger_processor processor (*this, transaction_a);
+	ledger_processor processor (*this, transaction_a, verification_a);
 	block_a->visit (processor);
 	if (processor.result == nano::block_status::progress)
 	{
 		++cache.block_count;
+		persist_block_counts (transaction_a);
+		// Successor of the previous block was updated
+		block_cache.erase (block_a->previous ());
+		// A rolled back copy of this block might have been cached from an older snapshot, its sideband is outdated
+		block_cache.erase (block_a->hash ());
 	}
 	return processor.result;
 }
@@ -941,11 +1251,105 @@ nano::uint128_t nano::ledger::weight (nano::account const & account_a) const
 	return cache.rep_weights.representation_get (account_a);
 }
 
+uint64_t nano::ledger::weights_version () const
+{
+	// Switching from bootstrap weights to ledger weights counts as a change
+	return cache.rep_weights.version () + (check_bootstrap_weights.load () ? 0 : 1);
+}
+
 nano::uint128_t nano::ledger::weight_exact (secure::transaction const & txn_a, nano::account const & representative_a) const
 {
 	return store.rep_weight.get (txn_a, representative_a);
 }
 
+void nano::ledger::prefetch (secure::transaction const & transaction, std::vector<std::shared_ptr<nano::block>> const & blocks) const
+{
+	// Blocks table, the flag marks previous blocks which are decoded rather than only checked for existence
+	std::map<nano::block_hash, bool> hashes;
+	for (auto const & block : blocks)
+	{
+		hashes.emplace (block->hash (), false);
+		if (!block->previous ().is_zero ())
+		{
+			hashes[block->previous ()] = true;
+		}
+		if (auto source = block->source_field ())
+		{
+			hashes.emplace (source.value (), false);
+		}
+		else if (auto link = block->link_field (); link && !link.value ().is_zero () && !is_epoch_link (link.value ()))
+		{
+			// Only receives use the link as a block hash, which is not known before the previous balance is
+			hashes.emplace (link.value ().as_block_hash (), false);
+		}
+	}
+	if (pruning)
+	{
+		for (auto const & [hash, decode] : hashes)
+		{
+			store.pruned.exists (transaction, hash);
+		}
+	}
+	std::unordered_map<nano::block_hash, nano::account> previous_accounts;
+	for (auto const & [hash, decode] : hashes)
+	{
+		if (!decode)
+		{
+			store.block.exists (transaction, hash);
+		}
+		else if (auto previous = any.block_get (transaction, hash))
+		{
+			previous_accounts.emplace (hash, previous->account ());
+		}
+	}
+
+	// Legacy blocks other than open only name their account through the previous block
+	std::set<nano::account> accounts;
+	std::set<nano::pending_key> pending;
+	std::set<nano::account> representatives;
+	for (auto const & block : blocks)
+	{
+		auto account = block->account_field ();
+		if (!account)
+		{
+			auto existing = previous_accounts.find (block->previous ());
+			if (existing == previous_accounts.end ())
+			{
+				continue;
+			}
+			account = existing->second;
+		}
+		accounts.insert (account.value ());
+		if (auto source = block->source_field ())
+		{
+			pending.emplace (account.value (), source.value ());
+		}
+		else if (auto link = block->link_field (); link && !link.value ().is_zero () && !is_epoch_link (link.value ()))
+		{
+			pending.emplace (account.value (), link.value ().as_block_hash ());
+		}
+		if (auto representative = block->representative_field ())
+		{
+			representatives.insert (representative.value ());
+		}
+	}
+	for (auto const & account : accounts)
+	{
+		if (auto info = store.account.get (transaction, account))
+		{
+			representatives.insert (info.value ().representative);
+		}
+	}
+	for (auto const & key : pending)
+	{
+		store.pending.get (transaction, key);
+	}
+	for (auto const & representative : representatives)
+	{
+		store.rep_weight.get (transaction, representative);
+	}
+}
+
 // Rollback blocks until `block_a' doesn't exist or it tries to penetrate the confirmation height
 bool nano::ledger::rollback (secure::write_transaction const & transaction_a, nano::block_hash const & block_a, std::vector<std::shared_ptr<nano::block>> & list_a)
 {
@@ -969,6 +1373,9 @@ bool nano::ledger::rollback (secure::write_transaction const & transaction_a, na
 			if (!error)
 			{
 				--cache.block_count;
+				// Rolled back block is deleted and the successor of its previous block cleared
+				block_cache.erase (block_l->hash ());
+				block_cache.erase (block_l->previous ());
 			}
 		}
 		else
@@ -976,6 +1383,7 @@ bool nano::ledger::rollback (secure::write_transaction const & transaction_a, na
 			error = true;
 		}
 	}
+	persist_block_counts (transaction_a);
 	return error;
 }
 
@@ -1195,6 +1603,7 @@ uint64_t nano::ledger::pruning_action (secure::write_transaction & transaction_a
 			release_assert (confirmed.block_exists (transaction_a, hash));
 			store.block.del (transaction_a, hash);
 			store.pruned.put (transaction_a, hash);
+			block_cache.erase (hash);
 			hash = block_l->previous ();
 			++pruned_count;
 			++cache.pruned_count;
@@ -1309,6 +1718,13 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		auto version = store.version.get (lmdb_transaction);
 		auto rocksdb_transaction (rocksdb_store->tx_begin_write ());
 		rocksdb_store->version.put (rocksdb_transaction, version);
+		for (auto counter : { nano::store::counter::block_count, nano::store::counter::account_count, nano::store::counter::cemented_count })
+		{
+			if (auto value = store.version.counter_get (lmdb_transaction, counter))
+			{
+				rocksdb_store->version.counter_put (rocksdb_transaction, counter, *value);
+			}
+		}
 
 		for (auto i (store.online_weight.begin (lmdb_transaction)), n (store.online_weight.end ()); i != n; ++i)
 		{
@@ -1401,5 +1817,6 @@ std::unique_ptr<nano::container_info_component> nano::ledger::collect_container_
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "bootstrap_weights", count, sizeof_element }));
 	composite->add_component (cache.rep_weights.collect_container_info ("rep_weights"));
+	composite->add_component (block_cache.collect_container_info ("block_cache"));
 	return composite;
 }
@@ -3,25 +3,31 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/secure/account_info.hpp>
+#include <nano/secure/block_cache.hpp>
 #include <nano/secure/generate_cache_flags.hpp>
 #include <nano/secure/ledger_cache.hpp>
 #include <nano/secure/pending_info.hpp>
 #include <nano/secure/transaction.hpp>
 
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 namespace nano::store
 {
 class component;
+enum class counter : uint8_t;
 }
 
 namespace nano
 {
 class block;
 enum class block_status;
+class confirmation_height_info;
 enum class epoch : uint8_t;
+enum class signature_verification;
 class ledger_constants;
 class ledger_set_any;
 class ledger_set_confirmed;
@@ -35,7 +41,7 @@ class ledger final
 	friend class receivable_iterator;
 
 public:
-	ledger (nano::store::component &, nano::stats &, nano::ledger_constants & constants, nano::generate_cache_flags const & = nano::generate_cache_flags{}, nano::uint128_t min_rep_weight_a = 0);
+	ledger (nano::store::component &, nano::stats &, nano::ledger_constants & constants, nano::generate_cache_flags const & = nano::generate_cache_flags{}, nano::uint128_t min_rep_weight_a = 0, std::size_t block_cache_size = nano::block_cache::default_capacity);
 	~ledger ();
 
 	/** Start read-write transaction */
@@ -50,6 +56,8 @@ public:
 	 * During bootstrap it returns the preconfigured bootstrap weights.
 	 */
 	nano::uint128_t weight (nano::account const &) const;
+	/* Changes whenever the result of `weight` might have changed */
+	uint64_t weights_version () const;
 	/* Returns the exact vote weight for the given representative by doing a database lookup */
 	nano::uint128_t weight_exact (secure::transaction const &, nano::account const &) const;
 	std::shared_ptr<nano::block> forked_block (secure::transaction const &, nano::block const &);
@@ -61,7 +69,29 @@ public:
 	std::pair<nano::block_hash, nano::block_hash> hash_root_random (secure::transaction const &) const;
 	std::optional<nano::pending_info> pending_info (secure::transaction const & transaction, nano::pending_key const & key) const;
 	std::deque<std::shared_ptr<nano::block>> confirm (secure::write_transaction const & transaction, nano::block_hash const & hash);
+	/**
+	 * Cements `hash` and its dependencies, handing newly cemented blocks to `callback` in chunks of at most `max_chunk` blocks.
+	 * Confirmation heights are written once per account per chunk before the callback runs, the callback is allowed to refresh the transaction.
+	 */
+	void confirm (secure::write_transaction const & transaction, nano::block_hash const & hash, std::size_t max_chunk, std::function<void (std::deque<std::shared_ptr<nano::block>> &)> const & callback);
+	/**
+	 * Read only counterpart of `confirm`, returns up to `max_blocks` blocks that confirming `hash` would cement, in cementing order.
+	 * Can be called concurrently under read transactions.
+	 */
+	std::deque<std::shared_ptr<nano::block>> confirm_resolve (secure::transaction const & transaction, nano::block_hash const & hash, std::size_t max_blocks) const;
+	/**
+	 * Cements blocks returned by an earlier `confirm_resolve` without walking dependencies again, blocks cemented in the meantime are skipped.
+	 * Returns true and writes nothing if the account chains changed since resolving, `confirm` has to walk them again in that case
+	 */
+	bool confirm_resolved (secure::write_transaction const & transaction, std::deque<std::shared_ptr<nano::block>> const & resolved, std::size_t max_chunk, std::function<void (std::deque<std::shared_ptr<nano::block>> &)> const & callback);
 	nano::block_status process (secure::write_transaction const & transaction, std::shared_ptr<nano::block> block);
+	/** Signatures already verified ahead of processing (`verification` other than unknown) are trusted and not checked again */
+	nano::block_status process (secure::write_transaction const & transaction, std::shared_ptr<nano::block> block, nano::signature_verification verification);
+	/**
+	 * Reads the entries processing `blocks` will look up, sorted by table and key so each table is read in one ordered pass instead of scattered point lookups.
+	 * Previous blocks are decoded into block_cache, which the ledger checks first. Other tables are only read to bring them into the backend's cache, as processing rewrites them
+	 */
+	void prefetch (secure::transaction const &, std::vector<std::shared_ptr<nano::block>> const & blocks) const;
 	bool rollback (secure::write_transaction const &, nano::block_hash const &, std::vector<std::shared_ptr<nano::block>> &);
 	bool rollback (secure::write_transaction const &, nano::block_hash const &);
 	void update_account (secure::write_transaction const &, nano::account const &, nano::account_info const &, nano::account_info const &);
@@ -82,6 +112,11 @@ public:
 	uint64_t block_count () const;
 	uint64_t account_count () const;
 	uint64_t pruned_count () const;
+	/**
+	 * Recounts blocks, accounts and cemented blocks from a single snapshot and corrects the persisted counters if they drifted from it.
+	 * This is a full scan of the accounts and confirmation height tables, meant to run in the background. Returns true if a correction was made
+	 */
+	bool verify_counts (std::function<bool ()> const & cancelled = [] () { return false; });
 	static nano::uint128_t const unit;
 	nano::ledger_constants & constants;
 	nano::store::component & store;
@@ -94,13 +129,26 @@ public:
 
 private:
 	void initialize (nano::generate_cache_flags const &);
-	void confirm (secure::write_transaction const & transaction, nano::block const & block);
+	/** Writes in-memory counters to the meta table within the transaction that changed them. Counters which are not tracked are invalidated instead */
+	void persist_counter (secure::write_transaction const &, nano::store::counter, uint64_t value);
+	void persist_block_counts (secure::write_transaction const &);
+	void persist_cemented_count (secure::write_transaction const &);
+	bool tracked (nano::store::counter) const;
+	/**
+	 * Visits the blocks that need cementing to confirm `hash` in dependency order, recording each one in `heights` which holds confirmation heights not yet written to the store.
+	 * Stops early when `visitor` returns false.
+	 */
+	void confirm_walk (secure::transaction const &, nano::block_hash const & hash, std::unordered_map<nano::account, nano::confirmation_height_info> & heights, std::function<bool (std::shared_ptr<nano::block> const &)> const & visitor) const;
 
+	nano::generate_cache_flags const generate_cache;
 	std::unique_ptr<ledger_set_any> any_impl;
 	std::unique_ptr<ledger_set_confirmed> confirmed_impl;
+	std::unique_ptr<nano::block_cache> block_cache_impl;
 
 public:
 	ledger_set_any & any;
 	ledger_set_confirmed & confirmed;
+	// Decoded blocks served by ledger_set_any::block_get
+	nano::block_cache & block_cache;
 };
 }
@@ -72,6 +72,11 @@ auto nano::ledger_set_any::account_upper_bound (secure::transaction const & tran
 	return account_lower_bound (transaction, account.number () + 1);
 }
 
+void nano::ledger_set_any::account_for_each_range (secure::transaction const & transaction, nano::account const & from, nano::account const & to, std::function<bool (nano::account const &, nano::account_info const &)> const & visitor) const
+{
+	ledger.store.account.for_each_range (transaction, from, to, visitor);
+}
+
 std::optional<nano::account> nano::ledger_set_any::block_account (secure::transaction const & transaction, nano::block_hash const & hash) const
 {
 	auto block_l = block_get (transaction, hash);
@@ -137,7 +142,21 @@ bool nano::ledger_set_any::block_exists_or_pruned (secure::transaction const & t
 
 std::shared_ptr<nano::block> nano::ledger_set_any::block_get (secure::transaction const & transaction, nano::block_hash const & hash) const
 {
-	return ledger.store.block.get (transaction, hash);
+	// Cached blocks might come from a different transaction snapshot or have an outdated successor, check them against the store
+	auto cached = ledger.block_cache.get (hash, [this, &transaction, &hash] (nano::block const & block) {
+		auto successor = ledger.store.block.successor_field (transaction, hash);
+		return successor && successor.value () == block.sideband ().successor;
+	});
+	if (cached)
+	{
+		return cached;
+	}
+	auto block = ledger.store.block.get (transaction, hash);
+	if (block)
+	{
+		ledger.block_cache.put (block, transaction.cache_generation ());
+	}
+	return block;
 }
 
 uint64_t nano::ledger_set_any::block_height (secure::transaction const & transaction, nano::block_hash const & hash) const
@@ -3,6 +3,7 @@
 #include <nano/secure/account_iterator.hpp>
 #include <nano/secure/receivable_iterator.hpp>
 
+#include <functional>
 #include <optional>
 
 namespace nano
@@ -44,6 +45,9 @@ public: // Operations on accounts
 	// Returns account_lower_bound (transaction, account + 1)
 	// Mirrors std::map::upper_bound
 	account_iterator account_upper_bound (secure::transaction const & transaction, nano::account const & account) const;
+	// Calls 'visitor' for the accounts in [from, to) in key order until it returns false, a zero 'to' visits all accounts from 'from' on
+	// Unlike account iterators it does not allocate per entry, for scans over large parts of the ledger
+	void account_for_each_range (secure::transaction const & transaction, nano::account const & from, nano::account const & to, std::function<bool (nano::account const &, nano::account_info const &)> const & visitor) const;
 
 public: // Operations on blocks
 	std::optional<nano::account> block_account (secure::transaction const & transaction, nano::block_hash const & hash) const;
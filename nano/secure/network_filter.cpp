@@ -1,29 +1,29 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/blocks.hpp>
-#include <nano/lib/locks.hpp>
 #include <nano/lib/stream.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/network_filter.hpp>
 
+#include <boost/endian/conversion.hpp>
+
+#include <cstring>
+
 nano::network_filter::network_filter (size_t size_a) :
-	items (size_a, nano::uint128_t{ 0 })
+	size{ size_a },
+	items{ std::make_unique<std::atomic<uint64_t>[]> (size_a) }
 {
-	nano::random_pool::generate_block (key, key.size ());
+	debug_assert (size > 0);
+	clear ();
+	nano::random_pool::generate_block (key.data (), key.size ());
 }
 
 bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, nano::uint128_t * digest_a)
 {
-	// Get hash before locking
 	auto digest (hash (bytes_a, count_a));
+	auto const value = fingerprint (digest);
 
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	auto & element (get_element (digest));
-	bool existed (element == digest);
-	if (!existed)
-	{
-		// Replace likely old element with a new one
-		element = digest;
-	}
+	// Replace likely old element with a new one, what was there tells whether this is a duplicate
+	bool existed (get_element (digest).exchange (value, std::memory_order_relaxed) == value);
 	if (digest_a)
 	{
 		*digest_a = digest;
@@ -33,24 +33,15 @@ bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, nano:
 
 void nano::network_filter::clear (nano::uint128_t const & digest_a)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	auto & element (get_element (digest_a));
-	if (element == digest_a)
-	{
-		element = nano::uint128_t{ 0 };
-	}
+	auto expected = fingerprint (digest_a);
+	get_element (digest_a).compare_exchange_strong (expected, 0, std::memory_order_relaxed);
 }
 
 void nano::network_filter::clear (std::vector<nano::uint128_t> const & digests_a)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
 	for (auto const & digest : digests_a)
 	{
-		auto & element (get_element (digest));
-		if (element == digest)
-		{
-			element = nano::uint128_t{ 0 };
-		}
+		clear (digest);
 	}
 }
 
@@ -67,8 +58,10 @@ void nano::network_filter::clear (OBJECT const & object_a)
 
 void nano::network_filter::clear ()
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	items.assign (items.size (), nano::uint128_t{ 0 });
+	for (size_t i = 0; i < size; ++i)
+	{
+		items[i].store (0, std::memory_order_relaxed);
+	}
 }
 
 template <typename OBJECT>
@@ -82,19 +75,100 @@ nano::uint128_t nano::network_filter::hash (OBJECT const & object_a) const
 	return hash (bytes.data (), bytes.size ());
 }
 
-nano::uint128_t & nano::network_filter::get_element (nano::uint128_t const & hash_a)
+std::atomic<uint64_t> & nano::network_filter::get_element (nano::uint128_t const & hash_a)
 {
-	debug_assert (!mutex.try_lock ());
-	debug_assert (items.size () > 0);
-	size_t index (hash_a % items.size ());
+	auto const index = static_cast<uint64_t> (hash_a >> 64) % size;
 	return items[index];
 }
 
+uint64_t nano::network_filter::fingerprint (nano::uint128_t const & hash_a)
+{
+	auto const result = static_cast<uint64_t> (hash_a);
+	return result != 0 ? result : 1;
+}
+
 nano::uint128_t nano::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
 {
-	nano::uint128_union digest{ 0 };
-	siphash_t siphash (key, static_cast<unsigned int> (key.size ()));
-	siphash.CalculateDigest (digest.bytes.data (), bytes_a, count_a);
+	return siphash (key, bytes_a, count_a);
+}
+
+namespace
+{
+uint64_t load_le64 (uint8_t const * bytes)
+{
+	uint64_t result;
+	std::memcpy (&result, bytes, sizeof (result));
+	return boost::endian::little_to_native (result);
+}
+
+uint64_t rotl (uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+void sip_rounds (uint64_t & v0, uint64_t & v1, uint64_t & v2, uint64_t & v3, int rounds)
+{
+	for (int i = 0; i < rounds; ++i)
+	{
+		v0 += v1;
+		v1 = rotl (v1, 13);
+		v1 ^= v0;
+		v0 = rotl (v0, 32);
+		v2 += v3;
+		v3 = rotl (v3, 16);
+		v3 ^= v2;
+		v0 += v3;
+		v3 = rotl (v3, 21);
+		v3 ^= v0;
+		v2 += v1;
+		v1 = rotl (v1, 17);
+		v1 ^= v2;
+		v2 = rotl (v2, 32);
+	}
+}
+}
+
+nano::uint128_t nano::network_filter::siphash (std::array<uint8_t, 16> const & key_a, uint8_t const * bytes_a, size_t count_a)
+{
+	auto const k0 = load_le64 (key_a.data ());
+	auto const k1 = load_le64 (key_a.data () + 8);
+	uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+	uint64_t v1 = 0x646f72616e646f6dULL ^ k1 ^ 0xee;
+	uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+	uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+	auto const tail = count_a & 7;
+	auto const end = bytes_a + (count_a - tail);
+	for (auto i = bytes_a; i != end; i += 8)
+	{
+		auto const m = load_le64 (i);
+		v3 ^= m;
+		sip_rounds (v0, v1, v2, v3, 2);
+		v0 ^= m;
+	}
+
+	uint64_t last = static_cast<uint64_t> (count_a) << 56;
+	for (size_t i = 0; i < tail; ++i)
+	{
+		last |= static_cast<uint64_t> (end[i]) << (8 * i);
+	}
+	v3 ^= last;
+	sip_rounds (v0, v1, v2, v3, 2);
+	v0 ^= last;
+
+	v2 ^= 0xee;
+	sip_rounds (v0, v1, v2, v3, 4);
+	auto const first = v0 ^ v1 ^ v2 ^ v3;
+	v1 ^= 0xdd;
+	sip_rounds (v0, v1, v2, v3, 4);
+	auto const second = v0 ^ v1 ^ v2 ^ v3;
+
+	// Little endian halves, matching the byte layout of the CryptoPP digest
+	nano::uint128_union digest;
+	auto const first_le = boost::endian::native_to_little (first);
+	auto const second_le = boost::endian::native_to_little (second);
+	std::memcpy (digest.bytes.data (), &first_le, sizeof (first_le));
+	std::memcpy (digest.bytes.data () + 8, &second_le, sizeof (second_le));
 	return digest.number ();
 }
 
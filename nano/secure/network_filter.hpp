@@ -3,14 +3,17 @@
 
 #include <nano/lib/numbers.hpp>
 
-#include <cryptopp/seckey.h>
-#include <cryptopp/siphash.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace nano
 {
 /**
  * A probabilistic duplicate filter based on directed map caches, using SipHash 2/4/128
- * The probability of false negatives (unique packet marked as duplicate) is the probability of a 128-bit SipHash collision.
+ * The upper half of the digest selects the slot and the lower half is stored in it, so slots are single 64-bit atomics and no lock is taken.
+ * The probability of false negatives (unique packet marked as duplicate) is the probability of two digests colliding on both the slot and the stored half.
  * The probability of false positives (duplicate packet marked as unique) shrinks with a larger filter.
  * @note This class is thread-safe.
  */
@@ -60,15 +63,21 @@ public:
 	template <typename OBJECT>
 	nano::uint128_t hash (OBJECT const & object_a) const;
 
-private:
-	using siphash_t = CryptoPP::SipHash<2, 4, true>;
+	/**
+	 * SipHash 2/4 with 128-bit output of \p count_a bytes starting from \p bytes_a, keyed with the 16 byte \p key_a.
+	 * Produces the same digest as CryptoPP::SipHash<2, 4, true> read as a big endian number, without its per call keying overhead.
+	 **/
+	static nano::uint128_t siphash (std::array<uint8_t, 16> const & key_a, uint8_t const * bytes_a, size_t count_a);
 
+private:
 	/**
 	 * Get element from digest.
-	 * @note must have a lock on mutex
-	 * @return a reference to the element with key \p hash_a
+	 * @return a reference to the slot for \p hash_a
 	 **/
-	nano::uint128_t & get_element (nano::uint128_t const & hash_a);
+	std::atomic<uint64_t> & get_element (nano::uint128_t const & hash_a);
+
+	/** Value stored in a slot for \p hash_a, never zero as zero marks an empty slot */
+	static uint64_t fingerprint (nano::uint128_t const & hash_a);
 
 	/**
 	 * Hashes \p count_a bytes starting from \p bytes_a .
@@ -76,8 +85,8 @@ private:
 	 **/
 	nano::uint128_t hash (uint8_t const * bytes_a, size_t count_a) const;
 
-	std::vector<nano::uint128_t> items;
-	CryptoPP::SecByteBlock key{ siphash_t::KEYLENGTH };
-	nano::mutex mutex{ mutex_identifier (mutexes::network_filter) };
+	size_t const size;
+	std::unique_ptr<std::atomic<uint64_t>[]> items;
+	std::array<uint8_t, 16> key;
 };
 }
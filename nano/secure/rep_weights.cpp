@@ -7,6 +7,8 @@ nano::rep_weights::rep_weights (nano::store::rep_weight & rep_weight_store_a, na
 	rep_weight_store{ rep_weight_store_a },
 	min_weight{ min_weight_a }
 {
+	current_table = std::make_unique<weight_table> (initial_table_capacity);
+	table = current_table.get ();
 }
 
 void nano::rep_weights::representation_add (store::write_transaction const & txn_a, nano::account const & rep_a, nano::uint128_t const & amount_a)
@@ -46,8 +48,7 @@ void nano::rep_weights::representation_put (nano::account const & account_a, nan
 
 nano::uint128_t nano::rep_weights::representation_get (nano::account const & account_a) const
 {
-	std::shared_lock lk{ mutex };
-	return get (account_a);
+	return table.load (std::memory_order_acquire)->get (account_a);
 }
 
 /** Makes a copy */
@@ -76,6 +77,7 @@ void nano::rep_weights::put_cache (nano::account const & account_a, nano::uint12
 		if (it != rep_amounts.end ())
 		{
 			rep_amounts.erase (it);
+			put_table (account_a, 0);
 		}
 	}
 	else
@@ -89,7 +91,44 @@ void nano::rep_weights::put_cache (nano::account const & account_a, nano::uint12
 		{
 			rep_amounts.emplace (account_a, amount);
 		}
+		put_table (account_a, amount);
 	}
+	// Bumped after the weight is published, a reader that observes the new version is guaranteed to read the new weight
+	version_m.fetch_add (1, std::memory_order_release);
+}
+
+void nano::rep_weights::put_table (nano::account const & account_a, nano::uint128_t const & representation_a)
+{
+	if (!current_table->put (account_a, representation_a))
+	{
+		// Out of free slots, rebuild from the authoritative map which already contains this update. The table is sized by the live weights only, so a table filled up by removed representatives is rebuilt at the same size
+		auto replacement = std::make_unique<weight_table> (capacity_for (rep_amounts.size ()));
+		for (auto const & [account, amount] : rep_amounts)
+		{
+			[[maybe_unused]] auto inserted = replacement->put (account, amount);
+			debug_assert (inserted);
+		}
+		table.store (replacement.get (), std::memory_order_release);
+
+		auto const now = std::chrono::steady_clock::now ();
+		while (!retired_tables.empty () && retired_tables.front ().first + retired_grace_period < now)
+		{
+			retired_tables.pop_front ();
+		}
+		retired_tables.emplace_back (now, std::move (current_table));
+		current_table = std::move (replacement);
+	}
+}
+
+std::size_t nano::rep_weights::capacity_for (std::size_t count)
+{
+	// At most half of the slots are used right after a rebuild
+	std::size_t capacity = initial_table_capacity;
+	while (capacity < count * 2)
+	{
+		capacity *= 2;
+	}
+	return capacity;
 }
 
 void nano::rep_weights::put_store (store::write_transaction const & txn_a, nano::account const & rep_a, nano::uint128_t const & previous_weight_a, nano::uint128_t const & new_weight_a)
@@ -126,16 +165,145 @@ std::size_t nano::rep_weights::size () const
 	return rep_amounts.size ();
 }
 
+std::size_t nano::rep_weights::table_capacity () const
+{
+	std::shared_lock guard{ mutex };
+	return current_table->capacity ();
+}
+
+uint64_t nano::rep_weights::version () const
+{
+	return version_m.load (std::memory_order_acquire);
+}
+
 std::unique_ptr<nano::container_info_component> nano::rep_weights::collect_container_info (std::string const & name) const
 {
 	size_t rep_amounts_count;
+	size_t current_capacity;
+	size_t retired_capacity{ 0 };
 
 	{
 		std::shared_lock guard{ mutex };
 		rep_amounts_count = rep_amounts.size ();
+		current_capacity = current_table->capacity ();
+		for (auto const & [time, retired] : retired_tables)
+		{
+			retired_capacity += retired->capacity ();
+		}
 	}
 	auto sizeof_element = sizeof (decltype (rep_amounts)::value_type);
 	auto composite = std::make_unique<nano::container_info_composite> (name);
 	composite->add_component (std::make_unique<nano::container_info_leaf> (container_info{ "rep_amounts", rep_amounts_count, sizeof_element }));
+	composite->add_component (std::make_unique<nano::container_info_leaf> (container_info{ "table", current_capacity, sizeof (weight_table::entry) }));
+	composite->add_component (std::make_unique<nano::container_info_leaf> (container_info{ "retired_tables", retired_capacity, sizeof (weight_table::entry) }));
 	return composite;
 }
+
+/*
+ * weight_table
+ */
+
+nano::rep_weights::weight_table::weight_table (std::size_t capacity) :
+	entries{ std::make_unique<entry[]> (capacity) },
+	mask{ capacity - 1 }
+{
+	debug_assert (capacity > 0 && (capacity & mask) == 0);
+}
+
+nano::uint128_t nano::rep_weights::weight_table::get (nano::account const & account_a) const
+{
+	for (auto index = std::hash<nano::account>{}(account_a) & mask;; index = (index + 1) & mask)
+	{
+		auto const & item = entries[index];
+		nano::account key;
+		nano::uint128_union value;
+		uint64_t sequence;
+		do
+		{
+			sequence = item.sequence.load (std::memory_order_acquire);
+			if (sequence == 0)
+			{
+				// Reached a never used slot, the account isn't present
+				return 0;
+			}
+			for (auto i = 0; i < 4; ++i)
+			{
+				key.qwords[i] = item.key[i].load (std::memory_order_relaxed);
+			}
+			for (auto i = 0; i < 2; ++i)
+			{
+				value.qwords[i] = item.value[i].load (std::memory_order_relaxed);
+			}
+			std::atomic_thread_fence (std::memory_order_acquire);
+		} while ((sequence & 1) != 0 || sequence != item.sequence.load (std::memory_order_relaxed));
+		if (key == account_a)
+		{
+			return value.number ();
+		}
+	}
+}
+
+bool nano::rep_weights::weight_table::put (nano::account const & account_a, nano::uint128_t const & representation_a)
+{
+	nano::uint128_union const value{ representation_a };
+	entry * reusable = nullptr;
+	for (auto index = std::hash<nano::account>{}(account_a) & mask;; index = (index + 1) & mask)
+	{
+		auto & item = entries[index];
+		// Only the writer modifies entries, no need to check the sequence here
+		if (item.sequence.load (std::memory_order_relaxed) == 0)
+		{
+			if (value.is_zero ())
+			{
+				return true;
+			}
+			if (reusable == nullptr)
+			{
+				// Keep at least a quarter of the slots free so lookups stay short and always terminate
+				if ((used + 1) * 4 > capacity () * 3)
+				{
+					return false;
+				}
+				++used;
+				reusable = &item;
+			}
+			write (*reusable, account_a, value);
+			return true;
+		}
+		nano::account key;
+		for (auto i = 0; i < 4; ++i)
+		{
+			key.qwords[i] = item.key[i].load (std::memory_order_relaxed);
+		}
+		if (key == account_a)
+		{
+			write (item, account_a, value);
+			return true;
+		}
+		if (reusable == nullptr && item.value[0].load (std::memory_order_relaxed) == 0 && item.value[1].load (std::memory_order_relaxed) == 0)
+		{
+			reusable = &item;
+		}
+	}
+}
+
+void nano::rep_weights::weight_table::write (entry & item, nano::account const & account_a, nano::uint128_union const & value_a)
+{
+	auto const sequence = item.sequence.load (std::memory_order_relaxed);
+	item.sequence.store (sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence (std::memory_order_release);
+	for (auto i = 0; i < 4; ++i)
+	{
+		item.key[i].store (account_a.qwords[i], std::memory_order_relaxed);
+	}
+	for (auto i = 0; i < 2; ++i)
+	{
+		item.value[i].store (value_a.qwords[i], std::memory_order_relaxed);
+	}
+	item.sequence.store (sequence + 2, std::memory_order_release);
+}
+
+std::size_t nano::rep_weights::weight_table::capacity () const
+{
+	return mask + 1;
+}
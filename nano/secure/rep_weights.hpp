@@ -3,6 +3,10 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <shared_mutex>
 #include <unordered_map>
@@ -29,15 +33,61 @@ public:
 	/* Only use this method when loading rep weights from the database table */
 	void copy_from (rep_weights & other_a);
 	size_t size () const;
+	/* Number of slots in the lookup table, which grows with the number of cached weights */
+	size_t table_capacity () const;
+	/* Incremented on every change to the cached weights */
+	uint64_t version () const;
 	std::unique_ptr<container_info_component> collect_container_info (std::string const &) const;
 
 private:
+	/**
+	 * Open addressing table mirroring `rep_amounts` so `representation_get` can be served without taking a lock.
+	 * Entries are only modified by a single writer holding `mutex`, each entry carries its own sequence counter so readers detect and retry torn reads.
+	 * Removed weights are left behind as zero valued entries whose slots are reused by later inserts.
+	 */
+	class weight_table final
+	{
+	public:
+		explicit weight_table (std::size_t capacity);
+		nano::uint128_t get (nano::account const &) const;
+		/** Returns false if the table is too full to insert a new entry */
+		bool put (nano::account const &, nano::uint128_t const &);
+		std::size_t capacity () const;
+
+	public:
+		class alignas (64) entry final
+		{
+		public:
+			std::atomic<uint64_t> sequence{ 0 };
+			std::array<std::atomic<uint64_t>, 4> key{};
+			std::array<std::atomic<uint64_t>, 2> value{};
+		};
+
+	private:
+		void write (entry &, nano::account const &, nano::uint128_union const &);
+		std::unique_ptr<entry[]> entries;
+		std::size_t const mask;
+		std::size_t used{ 0 };
+	};
+
+	void put_table (nano::account const & account_a, nano::uint128_t const & representation_a);
+	static std::size_t capacity_for (std::size_t count);
+
 	mutable std::shared_mutex mutex;
 	std::unordered_map<nano::account, nano::uint128_t> rep_amounts;
+	std::atomic<weight_table *> table;
+	std::unique_ptr<weight_table> current_table;
+	// Replaced tables with the time they were replaced. Readers may still be probing them, they are freed on a later replacement once the grace period has passed
+	std::deque<std::pair<std::chrono::steady_clock::time_point, std::unique_ptr<weight_table>>> retired_tables;
 	nano::store::rep_weight & rep_weight_store;
 	nano::uint128_t min_weight;
+	std::atomic<uint64_t> version_m{ 0 };
 	void put_cache (nano::account const & account_a, nano::uint128_union const & representation_a);
 	void put_store (store::write_transaction const & txn_a, nano::account const & rep_a, nano::uint128_t const & previous_weight_a, nano::uint128_t const & new_weight_a);
 	nano::uint128_t get (nano::account const & account_a) const;
+
+public:
+	static std::size_t constexpr initial_table_capacity = 1024;
+	static std::chrono::seconds constexpr retired_grace_period{ 60 };
 };
 }
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <nano/secure/block_cache.hpp>
 #include <nano/store/transaction.hpp>
 #include <nano/store/write_queue.hpp>
 
+#include <optional>
 #include <utility>
 
 namespace nano::secure
@@ -27,6 +29,12 @@ public:
 
 	// Conversion operator to const nano::store::transaction&
 	virtual operator const nano::store::transaction & () const = 0;
+
+	// Block cache generation taken before the snapshot was opened, empty if reads always see the latest ledger state
+	virtual std::optional<uint64_t> cache_generation () const
+	{
+		return std::nullopt;
+	}
 };
 
 class write_transaction : public transaction
@@ -95,10 +103,14 @@ public:
 class read_transaction : public transaction
 {
 	nano::store::read_transaction txn;
+	nano::block_cache const * cache;
+	mutable uint64_t generation;
 
 public:
-	explicit read_transaction (nano::store::read_transaction && t) noexcept :
-		txn{ std::move (t) }
+	explicit read_transaction (nano::store::read_transaction && t, nano::block_cache const * cache = nullptr, uint64_t generation = 0) noexcept :
+		txn{ std::move (t) },
+		cache{ cache },
+		generation{ generation }
 	{
 	}
 
@@ -110,12 +122,18 @@ public:
 
 	void refresh () const
 	{
+		auto const next = next_generation ();
 		txn.refresh ();
+		generation = next;
 	}
 
 	void refresh_if_needed (std::chrono::milliseconds max_age = std::chrono::milliseconds{ 500 }) const
 	{
-		txn.refresh_if_needed (max_age);
+		auto const next = next_generation ();
+		if (txn.refresh_if_needed (max_age))
+		{
+			generation = next;
+		}
 	}
 
 	// Conversion operator to const nano::store::transaction&
@@ -124,10 +142,22 @@ public:
 		return txn;
 	}
 
+	std::optional<uint64_t> cache_generation () const override
+	{
+		return generation;
+	}
+
 	// Additional conversion operator specific to nano::store::read_transaction
 	operator const nano::store::read_transaction & () const
 	{
 		return txn;
 	}
+
+private:
+	// Without a cache to ask the generation given on construction is kept, an outdated generation only makes caching more conservative
+	uint64_t next_generation () const
+	{
+		return cache ? cache->generation () : generation;
+	}
 };
 } // namespace nano::secure
@@ -0,0 +1,76 @@
+#include <nano/lib/timer.hpp>
+#include <nano/node/message_processor.hpp>
+#include <nano/node/messages.hpp>
+#include <nano/node/node.hpp>
+#include <nano/node/transport/fake.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+/*
+ * Pushes keepalives from `producers` threads, each with its own channel, and reports how long producers spent in `put` and how long until everything was processed
+ */
+void run_put_benchmark (bool staging)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.message_processor.staging = staging;
+	config.message_processor.max_queue = 1024 * 1024;
+	config.message_processor.max_staging = 1024 * 1024;
+	auto & node = *system.add_node (config);
+
+	int const producers = 16;
+	int const count = 50000;
+
+	std::vector<std::shared_ptr<nano::transport::channel>> channels;
+	for (auto i = 0; i < producers; ++i)
+	{
+		channels.push_back (std::make_shared<nano::transport::fake::channel> (node));
+	}
+
+	auto const initial = node.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in);
+
+	nano::timer<std::chrono::milliseconds> timer;
+	timer.start ();
+
+	std::atomic<uint64_t> put_time_ns{ 0 };
+	std::vector<std::thread> threads;
+	for (auto i = 0; i < producers; ++i)
+	{
+		threads.emplace_back ([&node, &put_time_ns, channel = channels[i]] () {
+			nano::keepalive message{ nano::dev::network_params.network };
+			auto const start = std::chrono::steady_clock::now ();
+			for (auto n = 0; n < count; ++n)
+			{
+				node.message_processor.put (std::make_unique<nano::keepalive> (message), channel);
+			}
+			put_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - start).count ();
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+
+	ASSERT_TIMELY_EQ (60s, initial + producers * count, node.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in));
+	auto const total = timer.since_start ();
+
+	std::cout << (staging ? "staging" : "direct") << ": "
+			  << "average put: " << put_time_ns / (producers * count) << " ns, "
+			  << "processed " << producers * count << " messages in " << total.count () << " ms" << std::endl;
+}
+}
+
+TEST (message_processor, perf_put)
+{
+	run_put_benchmark (false);
+	run_put_benchmark (true);
+}
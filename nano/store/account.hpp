@@ -31,5 +31,10 @@ public:
 	virtual iterator<nano::account, nano::account_info> rbegin (store::transaction const &) const = 0;
 	virtual iterator<nano::account, nano::account_info> end () const = 0;
 	virtual void for_each_par (std::function<void (store::read_transaction const &, iterator<nano::account, nano::account_info>, iterator<nano::account, nano::account_info>)> const &) const = 0;
+	/**
+	 * Visits accounts in [from, to) in key order until `visitor` returns false, reading to the end of the table if `to` is zero.
+	 * Rows are decoded in place by a backend cursor, so unlike iterator there is no heap allocation or virtual call per row.
+	 */
+	virtual void for_each_range (store::transaction const &, nano::account const & from, nano::account const & to, std::function<bool (nano::account const &, nano::account_info const &)> const & visitor) const = 0;
 };
 } // namespace nano::store
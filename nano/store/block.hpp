@@ -30,8 +30,12 @@ public:
 	virtual void put (store::write_transaction const &, nano::block_hash const &, nano::block const &) = 0;
 	virtual void raw_put (store::write_transaction const &, std::vector<uint8_t> const &, nano::block_hash const &) = 0;
 	virtual std::optional<nano::block_hash> successor (store::transaction const &, nano::block_hash const &) const = 0;
+	/** Returns the successor stored in the sideband, zero if the block has no successor, or nullopt if the block does not exist */
+	virtual std::optional<nano::block_hash> successor_field (store::transaction const &, nano::block_hash const &) const = 0;
 	virtual void successor_clear (store::write_transaction const &, nano::block_hash const &) = 0;
 	virtual std::shared_ptr<nano::block> get (store::transaction const &, nano::block_hash const &) const = 0;
+	/** Appends the block in its network serialization (type prefix and block, without sideband) to `buffer` without decoding it. Returns the successor, zero if there is none, or nullopt if the block does not exist */
+	virtual std::optional<nano::block_hash> serialized_get (store::transaction const &, nano::block_hash const &, std::vector<uint8_t> & buffer) const = 0;
 	virtual std::shared_ptr<nano::block> random (store::transaction const &) = 0;
 	virtual void del (store::write_transaction const &, nano::block_hash const &) = 0;
 	virtual bool exists (store::transaction const &, nano::block_hash const &) = 0;
@@ -6,8 +6,9 @@
 #include <nano/store/component.hpp>
 #include <nano/store/confirmation_height.hpp>
 #include <nano/store/rep_weight.hpp>
+#include <nano/store/version.hpp>
 
-nano::store::component::component (nano::store::block & block_store_a, nano::store::account & account_store_a, nano::store::pending & pending_store_a, nano::store::online_weight & online_weight_store_a, nano::store::pruned & pruned_store_a, nano::store::peer & peer_store_a, nano::store::confirmation_height & confirmation_height_store_a, nano::store::final_vote & final_vote_store_a, nano::store::version & version_store_a, nano::store::rep_weight & rep_weight_a, bool use_noops_a) :
+nano::store::component::component (nano::store::block & block_store_a, nano::store::account & account_store_a, nano::store::pending & pending_store_a, nano::store::online_weight & online_weight_store_a, nano::store::pruned & pruned_store_a, nano::store::peer & peer_store_a, nano::store::confirmation_height & confirmation_height_store_a, nano::store::final_vote & final_vote_store_a, nano::store::version & version_store_a, nano::store::rep_weight & rep_weight_a, bool use_noops_a, bool table_scoped_writes_a) :
 	block (block_store_a),
 	account (account_store_a),
 	pending (pending_store_a),
@@ -17,7 +18,7 @@ nano::store::component::component (nano::store::block & block_store_a, nano::sto
 	confirmation_height (confirmation_height_store_a),
 	final_vote (final_vote_store_a),
 	version (version_store_a),
-	write_queue (use_noops_a),
+	write_queue (use_noops_a, table_scoped_writes_a),
 	rep_weight (rep_weight_a)
 {
 }
@@ -39,4 +40,7 @@ void nano::store::component::initialize (store::write_transaction const & transa
 	++ledger_cache_a.account_count;
 	rep_weight.put (transaction_a, constants.genesis->account (), std::numeric_limits<nano::uint128_t>::max ());
 	ledger_cache_a.rep_weights.representation_put (constants.genesis->account (), std::numeric_limits<nano::uint128_t>::max ());
+	version.counter_put (transaction_a, nano::store::counter::block_count, ledger_cache_a.block_count);
+	version.counter_put (transaction_a, nano::store::counter::account_count, ledger_cache_a.account_count);
+	version.counter_put (transaction_a, nano::store::counter::cemented_count, ledger_cache_a.cemented_count);
 }
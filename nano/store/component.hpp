@@ -54,7 +54,8 @@ namespace store
 		nano::store::final_vote &,
 		nano::store::version &,
 		nano::store::rep_weight &,
-		bool use_noops_a
+		bool use_noops_a,
+		bool table_scoped_writes_a = false
 	);
 		// clang-format on
 		virtual ~component () = default;
@@ -36,5 +36,7 @@ public:
 	virtual iterator<nano::account, nano::confirmation_height_info> begin (store::transaction const & transaction_a) const = 0;
 	virtual iterator<nano::account, nano::confirmation_height_info> end () const = 0;
 	virtual void for_each_par (std::function<void (store::read_transaction const &, iterator<nano::account, nano::confirmation_height_info>, iterator<nano::account, nano::confirmation_height_info>)> const &) const = 0;
+	/** Visits confirmation heights in [from, to) in key order until `visitor` returns false, see account::for_each_range */
+	virtual void for_each_range (store::transaction const &, nano::account const & from, nano::account const & to, std::function<bool (nano::account const &, nano::confirmation_height_info const &)> const & visitor) const = 0;
 };
 } // namespace nano::store
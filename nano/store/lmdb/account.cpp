@@ -71,3 +71,8 @@ void nano::store::lmdb::account::for_each_par (std::function<void (store::read_t
 		action_a (transaction, this->begin (transaction, start), !is_last ? this->begin (transaction, end) : this->end ());
 	});
 }
+
+void nano::store::lmdb::account::for_each_range (store::transaction const & transaction_a, nano::account const & from_a, nano::account const & to_a, std::function<bool (nano::account const &, nano::account_info const &)> const & visitor_a) const
+{
+	store.for_each_range<nano::account, nano::account_info> (transaction_a, tables::accounts, from_a, to_a, visitor_a);
+}
@@ -27,6 +27,7 @@ public:
 	store::iterator<nano::account, nano::account_info> rbegin (store::transaction const & transaction_a) const override;
 	store::iterator<nano::account, nano::account_info> end () const override;
 	void for_each_par (std::function<void (store::read_transaction const &, store::iterator<nano::account, nano::account_info>, store::iterator<nano::account, nano::account_info>)> const & action_a) const override;
+	void for_each_range (store::transaction const & transaction_a, nano::account const & from_a, nano::account const & to_a, std::function<bool (nano::account const &, nano::account_info const &)> const & visitor_a) const override;
 
 	/**
 	 * Maps account v1 to account information, head, rep, open, balance, timestamp and block count. (Removed)
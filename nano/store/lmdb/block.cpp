@@ -51,26 +51,47 @@ void nano::store::lmdb::block::raw_put (store::write_transaction const & transac
 
 std::optional<nano::block_hash> nano::store::lmdb::block::successor (store::transaction const & transaction_a, nano::block_hash const & hash_a) const
 {
-	nano::store::lmdb::db_val value;
-	block_raw_get (transaction_a, hash_a, value);
-	nano::block_hash result;
-	if (value.size () != 0)
+	auto result = successor_field (transaction_a, hash_a);
+	if (!result || result->is_zero ())
 	{
-		debug_assert (value.size () >= result.bytes.size ());
-		auto type = block_type_from_raw (value.data ());
-		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()) + block_successor_offset (transaction_a, value.size (), type), result.bytes.size ());
-		auto error (nano::try_read (stream, result.bytes));
-		(void)error;
-		debug_assert (!error);
+		return std::nullopt;
 	}
-	else
+	return result;
+}
+
+std::optional<nano::block_hash> nano::store::lmdb::block::successor_field (store::transaction const & transaction_a, nano::block_hash const & hash_a) const
+{
+	nano::store::lmdb::db_val value;
+	block_raw_get (transaction_a, hash_a, value);
+	if (value.size () == 0)
 	{
-		result.clear ();
+		return std::nullopt;
 	}
-	if (result.is_zero ())
+	nano::block_hash result;
+	debug_assert (value.size () >= result.bytes.size ());
+	auto type = block_type_from_raw (value.data ());
+	nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()) + block_successor_offset (transaction_a, value.size (), type), result.bytes.size ());
+	auto error (nano::try_read (stream, result.bytes));
+	(void)error;
+	debug_assert (!error);
+	return result;
+}
+
+std::optional<nano::block_hash> nano::store::lmdb::block::serialized_get (store::transaction const & transaction_a, nano::block_hash const & hash_a, std::vector<uint8_t> & buffer_a) const
+{
+	nano::store::lmdb::db_val value;
+	block_raw_get (transaction_a, hash_a, value);
+	if (value.size () == 0)
 	{
 		return std::nullopt;
 	}
+	// Stored entries are the serialized block followed by the sideband, which starts with the successor
+	auto type = block_type_from_raw (value.data ());
+	auto data = reinterpret_cast<uint8_t const *> (value.data ());
+	auto successor_offset = block_successor_offset (transaction_a, value.size (), type);
+	buffer_a.insert (buffer_a.end (), data, data + successor_offset);
+	nano::block_hash result;
+	std::copy_n (data + successor_offset, result.bytes.size (), result.bytes.begin ());
 	return result;
 }
 
@@ -27,6 +27,7 @@ public:
 	store::iterator<nano::account, nano::confirmation_height_info> begin (store::transaction const & transaction_a) const override;
 	store::iterator<nano::account, nano::confirmation_height_info> end () const override;
 	void for_each_par (std::function<void (store::read_transaction const &, store::iterator<nano::account, nano::confirmation_height_info>, store::iterator<nano::account, nano::confirmation_height_info>)> const & action_a) const override;
+	void for_each_range (store::transaction const & transaction_a, nano::account const & from_a, nano::account const & to_a, std::function<bool (nano::account const &, nano::confirmation_height_info const &)> const & visitor_a) const override;
 
 	/*
 	 * Confirmation height of an account, and the hash for the block at that height
@@ -8,6 +8,8 @@
 
 #include <lmdb/libraries/liblmdb/lmdb.h>
 
+#include <cstring>
+
 namespace nano::store::lmdb
 {
 template <typename T, typename U>
@@ -168,6 +170,69 @@ public:
 	std::pair<store::db_val<MDB_val>, store::db_val<MDB_val>> current;
 };
 
+/**
+ * Forward cursor over the key range [from, to) of a table, rows are decoded straight from the memory mapped pages.
+ * Unlike store::iterator it is not heap allocated and has no virtual dispatch per row. A zero `to` reads to the end of the table.
+ */
+template <typename Key, typename Value>
+class cursor final
+{
+public:
+	cursor (store::transaction const & transaction_a, env const & env_a, MDB_dbi db_a, Key const & from_a, Key const & to_a) :
+		to{ to_a }
+	{
+		auto status (mdb_cursor_open (env_a.tx (transaction_a), db_a, &handle));
+		release_assert (status == 0);
+		current.first = store::db_val<MDB_val>{ from_a };
+		seek (MDB_SET_RANGE);
+	}
+
+	~cursor ()
+	{
+		mdb_cursor_close (handle);
+	}
+
+	cursor (cursor<Key, Value> const &) = delete;
+	cursor<Key, Value> & operator= (cursor<Key, Value> const &) = delete;
+
+	bool valid () const
+	{
+		return current.first.size () != 0;
+	}
+
+	void next ()
+	{
+		debug_assert (valid ());
+		seek (MDB_NEXT);
+	}
+
+	Key key () const
+	{
+		return static_cast<Key> (current.first);
+	}
+
+	Value value () const
+	{
+		return static_cast<Value> (current.second);
+	}
+
+private:
+	void seek (MDB_cursor_op operation_a)
+	{
+		auto status (mdb_cursor_get (handle, &current.first.value, &current.second.value, operation_a));
+		release_assert (status == 0 || status == MDB_NOTFOUND);
+		if (status == MDB_NOTFOUND || current.first.size () != sizeof (Key) || (!to.is_zero () && std::memcmp (current.first.data (), store::db_val<MDB_val>{ to }.data (), sizeof (Key)) >= 0))
+		{
+			current.first = store::db_val<MDB_val> ();
+			current.second = store::db_val<MDB_val> ();
+		}
+	}
+
+	Key const to;
+	MDB_cursor * handle{ nullptr };
+	std::pair<store::db_val<MDB_val>, store::db_val<MDB_val>> current;
+};
+
 /**
  * Iterates the key/value pairs of two stores merged together
  */
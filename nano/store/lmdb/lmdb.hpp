@@ -105,6 +105,14 @@ public:
 		return store::iterator<Key, Value> (std::make_unique<nano::store::lmdb::iterator<Key, Value>> (transaction_a, env, table_to_dbi (table_a), key));
 	}
 
+	template <typename Key, typename Value>
+	void for_each_range (store::transaction const & transaction_a, tables table_a, Key const & from_a, Key const & to_a, std::function<bool (Key const &, Value const &)> const & visitor_a) const
+	{
+		for (nano::store::lmdb::cursor<Key, Value> cursor{ transaction_a, env, table_to_dbi (table_a), from_a, to_a }; cursor.valid () && visitor_a (cursor.key (), cursor.value ()); cursor.next ())
+		{
+		}
+	}
+
 	bool init_error () const override;
 
 	uint64_t count (store::transaction const &, MDB_dbi) const;
@@ -66,3 +66,8 @@ void nano::store::lmdb::rep_weight::for_each_par (std::function<void (store::rea
 		action_a (transaction, this->begin (transaction, start), !is_last ? this->begin (transaction, end) : this->end ());
 	});
 }
+
+void nano::store::lmdb::rep_weight::for_each_range (store::transaction const & transaction_a, nano::account const & from_a, nano::account const & to_a, std::function<bool (nano::account const &, nano::uint128_union const &)> const & visitor_a) const
+{
+	store.for_each_range<nano::account, nano::uint128_union> (transaction_a, tables::rep_weights, from_a, to_a, visitor_a);
+}
@@ -26,3 +26,31 @@ int nano::store::lmdb::version::get (store::transaction const & transaction_a) c
 	}
 	return result;
 }
+
+void nano::store::lmdb::version::counter_put (store::write_transaction const & transaction, nano::store::counter counter, uint64_t value)
+{
+	nano::uint256_union key{ static_cast<uint64_t> (counter) };
+	nano::uint256_union data{ value };
+	auto status = store.put (transaction, tables::meta, key, data);
+	store.release_assert_success (status);
+}
+
+std::optional<uint64_t> nano::store::lmdb::version::counter_get (store::transaction const & transaction, nano::store::counter counter) const
+{
+	nano::uint256_union key{ static_cast<uint64_t> (counter) };
+	nano::store::lmdb::db_val data;
+	auto status = store.get (transaction, tables::meta, key, data);
+	if (store.success (status))
+	{
+		nano::uint256_union value{ data };
+		return value.number ().convert_to<uint64_t> ();
+	}
+	return std::nullopt;
+}
+
+void nano::store::lmdb::version::counter_del (store::write_transaction const & transaction, nano::store::counter counter)
+{
+	nano::uint256_union key{ static_cast<uint64_t> (counter) };
+	auto status = store.del (transaction, tables::meta, key);
+	release_assert (store.success (status) || store.not_found (status));
+}
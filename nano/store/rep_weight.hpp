@@ -28,5 +28,7 @@ public:
 	virtual store::iterator<nano::account, nano::uint128_union> begin (store::transaction const & transaction_a) const = 0;
 	virtual store::iterator<nano::account, nano::uint128_union> end () const = 0;
 	virtual void for_each_par (std::function<void (store::read_transaction const &, store::iterator<nano::account, nano::uint128_union>, store::iterator<nano::account, nano::uint128_union>)> const & action_a) const = 0;
+	/** Visits representative weights in [from, to) in key order until `visitor` returns false, see account::for_each_range */
+	virtual void for_each_range (store::transaction const &, nano::account const & from, nano::account const & to, std::function<bool (nano::account const &, nano::uint128_union const &)> const & visitor) const = 0;
 };
 }
@@ -23,6 +23,8 @@ public:
 	void put (store::write_transaction const & transaction_a, nano::block_hash const & hash_a, nano::block const & block_a) override;
 	void raw_put (store::write_transaction const & transaction_a, std::vector<uint8_t> const & data, nano::block_hash const & hash_a) override;
 	std::optional<nano::block_hash> successor (store::transaction const & transaction_a, nano::block_hash const & hash_a) const override;
+	std::optional<nano::block_hash> successor_field (store::transaction const & transaction_a, nano::block_hash const & hash_a) const override;
+	std::optional<nano::block_hash> serialized_get (store::transaction const & transaction_a, nano::block_hash const & hash_a, std::vector<uint8_t> & buffer_a) const override;
 	void successor_clear (store::write_transaction const & transaction_a, nano::block_hash const & hash_a) override;
 	std::shared_ptr<nano::block> get (store::transaction const & transaction_a, nano::block_hash const & hash_a) const override;
 	std::shared_ptr<nano::block> random (store::transaction const & transaction_a) override;
@@ -82,3 +82,8 @@ void nano::store::rocksdb::confirmation_height::for_each_par (std::function<void
 		action_a (transaction, this->begin (transaction, start), !is_last ? this->begin (transaction, end) : this->end ());
 	});
 }
+
+void nano::store::rocksdb::confirmation_height::for_each_range (store::transaction const & transaction_a, nano::account const & from_a, nano::account const & to_a, std::function<bool (nano::account const &, nano::confirmation_height_info const &)> const & visitor_a) const
+{
+	store.for_each_range<nano::account, nano::confirmation_height_info> (transaction_a, tables::confirmation_height, from_a, to_a, visitor_a);
+}
@@ -203,4 +203,82 @@ private:
 		return static_cast<::rocksdb::Transaction *> (transaction_a.get_handle ());
 	}
 };
+
+/**
+ * Forward cursor over the key range [from, to) of a column family, rows are decoded straight from the slices RocksDB returns.
+ * Unlike store::iterator it is not heap allocated by the store and has no virtual dispatch per row. A zero `to` reads to the end of the column family.
+ */
+template <typename Key, typename Value>
+class cursor final
+{
+public:
+	cursor (::rocksdb::DB * db, store::transaction const & transaction_a, ::rocksdb::ColumnFamilyHandle * handle_a, Key const & from_a, Key const & to_a) :
+		to{ to_a }
+	{
+		// Same as iterator, range scans don't fill the block cache
+		::rocksdb::ReadOptions read_options = is_read (transaction_a) ? snapshot_options (transaction_a) : ::rocksdb::ReadOptions{};
+		read_options.fill_cache = false;
+		if (!to.is_zero ())
+		{
+			upper_bound = nano::store::rocksdb::db_val{ to };
+			read_options.iterate_upper_bound = &upper_bound;
+		}
+		if (is_read (transaction_a))
+		{
+			handle.reset (db->NewIterator (read_options, handle_a));
+		}
+		else
+		{
+			handle.reset (static_cast<::rocksdb::Transaction *> (transaction_a.get_handle ())->GetIterator (read_options, handle_a));
+		}
+		handle->Seek (nano::store::rocksdb::db_val{ from_a });
+		fill ();
+	}
+
+	cursor (cursor<Key, Value> const &) = delete;
+	cursor<Key, Value> & operator= (cursor<Key, Value> const &) = delete;
+
+	bool valid () const
+	{
+		return current.first.size () != 0;
+	}
+
+	void next ()
+	{
+		debug_assert (valid ());
+		handle->Next ();
+		fill ();
+	}
+
+	Key key () const
+	{
+		return static_cast<Key> (current.first);
+	}
+
+	Value value () const
+	{
+		return static_cast<Value> (current.second);
+	}
+
+private:
+	void fill ()
+	{
+		// The upper bound is checked here as well, iterators over a write transaction's pending writes may not honour it
+		if (handle->Valid () && handle->key ().size () == sizeof (Key) && (to.is_zero () || handle->key ().compare (upper_bound) < 0))
+		{
+			current.first = handle->key ();
+			current.second = handle->value ();
+		}
+		else
+		{
+			current.first = nano::store::rocksdb::db_val{};
+			current.second = nano::store::rocksdb::db_val{};
+		}
+	}
+
+	Key const to;
+	::rocksdb::Slice upper_bound;
+	std::unique_ptr<::rocksdb::Iterator> handle;
+	std::pair<nano::store::rocksdb::db_val, nano::store::rocksdb::db_val> current;
+};
 }
@@ -23,5 +23,6 @@ public:
 	store::iterator<nano::account, nano::uint128_union> begin (store::transaction const & txn_a) const override;
 	store::iterator<nano::account, nano::uint128_union> end () const override;
 	void for_each_par (std::function<void (store::read_transaction const &, store::iterator<nano::account, nano::uint128_union>, store::iterator<nano::account, nano::uint128_union>)> const & action_a) const override;
+	void for_each_range (store::transaction const & transaction_a, nano::account const & from_a, nano::account const & to_a, std::function<bool (nano::account const &, nano::uint128_union const &)> const & visitor_a) const override;
 };
 }
@@ -48,7 +48,8 @@ nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesy
 		final_vote_store,
 		version_store,
 		rep_weight_store,
-		!force_use_write_queue // write_queue use_noops
+		!force_use_write_queue, // write_queue use_noops
+		force_use_write_queue // write_queue table_scoped, writers lock per column family so disjoint ones can still run concurrently
 	},
 	// clang-format on
 	block_store{ *this },
@@ -408,7 +409,7 @@ rocksdb::ColumnFamilyOptions nano::store::rocksdb::component::get_cf_options (st
 	}
 	else if (cf_name_a == "meta" || cf_name_a == "online_weight" || cf_name_a == "peers")
 	{
-		// Meta - It contains just version key
+		// Meta - It contains the version key and the persisted ledger counters
 		// Online weight - Periodically deleted
 		// Peers - Cleaned periodically, a lot of deletions. This is never read outside of initializing? Keep this small
 		cf_options = get_small_cf_options (small_table_factory);
@@ -97,6 +97,14 @@ public:
 		return store::iterator<Key, Value> (std::make_unique<nano::store::rocksdb::iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), &key, true));
 	}
 
+	template <typename Key, typename Value>
+	void for_each_range (store::transaction const & transaction_a, tables table_a, Key const & from_a, Key const & to_a, std::function<bool (Key const &, Value const &)> const & visitor_a) const
+	{
+		for (nano::store::rocksdb::cursor<Key, Value> cursor{ db.get (), transaction_a, table_to_column_family (table_a), from_a, to_a }; cursor.valid () && visitor_a (cursor.key (), cursor.value ()); cursor.next ())
+		{
+		}
+	}
+
 	bool init_error () const override;
 
 	std::string error_string (int status) const override;
@@ -26,3 +26,35 @@ int nano::store::rocksdb::version::get (store::transaction const & transaction_a
 	}
 	return result;
 }
+
+void nano::store::rocksdb::version::counter_put (store::write_transaction const & transaction, nano::store::counter counter, uint64_t value)
+{
+	nano::uint256_union key{ static_cast<uint64_t> (counter) };
+	nano::uint256_union data{ value };
+	auto status = store.put (transaction, tables::meta, key, data);
+	store.release_assert_success (status);
+}
+
+std::optional<uint64_t> nano::store::rocksdb::version::counter_get (store::transaction const & transaction, nano::store::counter counter) const
+{
+	nano::uint256_union key{ static_cast<uint64_t> (counter) };
+	nano::store::rocksdb::db_val data;
+	auto status = store.get (transaction, tables::meta, key, data);
+	if (store.success (status))
+	{
+		nano::uint256_union value{ data };
+		return value.number ().convert_to<uint64_t> ();
+	}
+	return std::nullopt;
+}
+
+void nano::store::rocksdb::version::counter_del (store::write_transaction const & transaction, nano::store::counter counter)
+{
+	nano::uint256_union key{ static_cast<uint64_t> (counter) };
+	// RocksDB deletes require the key to exist
+	if (store.exists (transaction, tables::meta, key))
+	{
+		auto status = store.del (transaction, tables::meta, key);
+		store.release_assert_success (status);
+	}
+}
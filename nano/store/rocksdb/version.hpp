@@ -13,5 +13,8 @@ public:
 	explicit version (nano::store::rocksdb::component & store_a);
 	void put (store::write_transaction const & transaction_a, int version_a) override;
 	int get (store::transaction const & transaction_a) const override;
+	void counter_put (store::write_transaction const &, nano::store::counter, uint64_t) override;
+	std::optional<uint64_t> counter_get (store::transaction const &, nano::store::counter) const override;
+	void counter_del (store::write_transaction const &, nano::store::counter) override;
 };
 } // namespace nano::store::rocksdb
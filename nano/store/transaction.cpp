@@ -66,13 +66,15 @@ void nano::store::read_transaction::refresh () const
 	renew ();
 }
 
-void nano::store::read_transaction::refresh_if_needed (std::chrono::milliseconds max_age) const
+bool nano::store::read_transaction::refresh_if_needed (std::chrono::milliseconds max_age) const
 {
 	auto now = std::chrono::steady_clock::now ();
 	if (now - start > max_age)
 	{
 		refresh ();
+		return true;
 	}
+	return false;
 }
 
 /*
@@ -56,7 +56,8 @@ public:
 	void reset () const;
 	void renew () const;
 	void refresh () const;
-	void refresh_if_needed (std::chrono::milliseconds max_age = std::chrono::milliseconds{ 500 }) const;
+	/** Returns true if the transaction was refreshed */
+	bool refresh_if_needed (std::chrono::milliseconds max_age = std::chrono::milliseconds{ 500 }) const;
 
 private:
 	std::unique_ptr<read_transaction_impl> impl;
@@ -4,6 +4,7 @@
 #include <nano/store/component.hpp>
 
 #include <functional>
+#include <optional>
 
 namespace nano
 {
@@ -12,12 +13,26 @@ class block_hash;
 namespace nano::store
 {
 /**
- * Manages version storage
+ * Ledger counters persisted in the meta table, each value is the meta key it is stored under
+ */
+enum class counter : uint8_t
+{
+	block_count = 2,
+	account_count = 3,
+	cemented_count = 4,
+};
+
+/**
+ * Manages version storage and the other entries of the meta table
  */
 class version
 {
 public:
 	virtual void put (store::write_transaction const &, int) = 0;
 	virtual int get (store::transaction const &) const = 0;
+	virtual void counter_put (store::write_transaction const &, nano::store::counter, uint64_t) = 0;
+	/** Returns nullopt if the counter was never written or has been invalidated */
+	virtual std::optional<uint64_t> counter_get (store::transaction const &, nano::store::counter) const = 0;
+	virtual void counter_del (store::write_transaction const &, nano::store::counter) = 0;
 };
 } // namespace nano::store
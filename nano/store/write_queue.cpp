@@ -8,9 +8,10 @@
  * write_guard
  */
 
-nano::store::write_guard::write_guard (write_queue & queue, writer type) :
+nano::store::write_guard::write_guard (write_queue & queue, writer type, std::vector<nano::tables> tables) :
 	queue{ queue },
-	type{ type }
+	type{ type },
+	tables{ std::move (tables) }
 {
 	renew ();
 }
@@ -18,6 +19,7 @@ nano::store::write_guard::write_guard (write_queue & queue, writer type) :
 nano::store::write_guard::write_guard (write_guard && other) noexcept :
 	queue{ other.queue },
 	type{ other.type },
+	tables{ other.tables },
 	owns{ other.owns }
 {
 	other.owns = false;
@@ -46,7 +48,7 @@ void nano::store::write_guard::release ()
 void nano::store::write_guard::renew ()
 {
 	release_assert (!owns);
-	queue.acquire (type);
+	queue.acquire (type, tables);
 	owns = true;
 }
 
@@ -54,21 +56,22 @@ void nano::store::write_guard::renew ()
  * write_queue
  */
 
-nano::store::write_queue::write_queue (bool use_noops_a) :
-	use_noops{ use_noops_a }
+nano::store::write_queue::write_queue (bool use_noops_a, bool table_scoped_a) :
+	use_noops{ use_noops_a },
+	table_scoped{ table_scoped_a }
 {
 }
 
-nano::store::write_guard nano::store::write_queue::wait (writer writer)
+nano::store::write_guard nano::store::write_queue::wait (writer writer, std::vector<nano::tables> const & tables)
 {
-	return write_guard{ *this, writer };
+	return write_guard{ *this, writer, tables };
 }
 
 bool nano::store::write_queue::contains (writer writer) const
 {
 	debug_assert (!use_noops);
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	return std::find (queue.cbegin (), queue.cend (), writer) != queue.cend ();
+	return std::any_of (queue.cbegin (), queue.cend (), [writer] (auto const & item) { return item.type == writer; });
 }
 
 void nano::store::write_queue::pop ()
@@ -81,7 +84,7 @@ void nano::store::write_queue::pop ()
 	condition.notify_all ();
 }
 
-void nano::store::write_queue::acquire (writer writer)
+void nano::store::write_queue::acquire (writer writer, std::vector<nano::tables> const & tables)
 {
 	if (use_noops)
 	{
@@ -90,17 +93,38 @@ void nano::store::write_queue::acquire (writer writer)
 
 	nano::unique_lock<nano::mutex> lock{ mutex };
 
+	auto find = [this, writer] () {
+		return std::find_if (queue.cbegin (), queue.cend (), [writer] (auto const & item) { return item.type == writer; });
+	};
+
 	// There should be no duplicates in the queue
-	debug_assert (std::none_of (queue.cbegin (), queue.cend (), [writer] (auto const & item) { return item == writer; }));
+	debug_assert (find () == queue.cend ());
 
 	// Add writer to the end of the queue if it's not already waiting
-	auto exists = std::find (queue.cbegin (), queue.cend (), writer) != queue.cend ();
-	if (!exists)
+	if (find () == queue.cend ())
+	{
+		queue.push_back ({ writer, tables });
+	}
+
+	condition.wait (lock, [&] () { return granted (find ()); });
+}
+
+bool nano::store::write_queue::conflicts (entry const & first, entry const & second) const
+{
+	if (!table_scoped || first.tables.empty () || second.tables.empty ())
 	{
-		queue.push_back (writer);
+		return true;
 	}
+	return std::any_of (first.tables.cbegin (), first.tables.cend (), [&second] (auto const & table) {
+		return std::find (second.tables.cbegin (), second.tables.cend (), table) != second.tables.cend ();
+	});
+}
 
-	condition.wait (lock, [&] () { return queue.front () == writer; });
+bool nano::store::write_queue::granted (std::deque<entry>::const_iterator position) const
+{
+	debug_assert (position != queue.cend ());
+	// Writers ahead in the queue either hold their tables or are waiting for them, overtaking a waiting one would let it starve
+	return std::none_of (queue.cbegin (), position, [this, position] (auto const & item) { return conflicts (item, *position); });
 }
 
 void nano::store::write_queue::release (writer writer)
@@ -111,9 +135,11 @@ void nano::store::write_queue::release (writer writer)
 	}
 	{
 		nano::lock_guard<nano::mutex> guard{ mutex };
-		release_assert (!queue.empty ());
-		release_assert (queue.front () == writer);
-		queue.pop_front ();
+		auto existing = std::find_if (queue.cbegin (), queue.cend (), [writer] (auto const & item) { return item.type == writer; });
+		release_assert (existing != queue.cend ());
+		// Without table scoping only the head of the queue can hold the guard
+		release_assert (table_scoped || existing == queue.cbegin ());
+		queue.erase (existing);
 	}
 	condition.notify_all ();
 }
\ No newline at end of file
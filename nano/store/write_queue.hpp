@@ -1,10 +1,12 @@
 #pragma once
 
 #include <nano/lib/locks.hpp>
+#include <nano/store/tables.hpp>
 
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <vector>
 
 namespace nano::store
 {
@@ -25,7 +27,7 @@ class write_queue;
 class write_guard final
 {
 public:
-	explicit write_guard (write_queue & queue, writer type);
+	explicit write_guard (write_queue & queue, writer type, std::vector<nano::tables> tables = {});
 	~write_guard ();
 
 	write_guard (write_guard const &) = delete;
@@ -39,6 +41,8 @@ public:
 	bool is_owned () const;
 
 	writer const type;
+	/** Tables this writer needs, empty means all of them */
+	std::vector<nano::tables> const tables;
 
 private:
 	write_queue & queue;
@@ -48,16 +52,18 @@ private:
 /**
  * Allocates database write access in a fair maner rather than directly waiting for mutex aquisition
  * Users should wait() for access to database write transaction and hold the write_guard until complete
+ * When table scoped, a writer is let through as soon as no writer ahead of it in the queue needs any of its tables,
+ * so writers with disjoint tables run concurrently. This is for backends which lock per table, otherwise there is a single writer at a time
  */
 class write_queue final
 {
 	friend class write_guard;
 
 public:
-	explicit write_queue (bool use_noops);
+	explicit write_queue (bool use_noops, bool table_scoped = false);
 
-	/** Blocks until we are at the head of the queue and blocks other waiters until write_guard goes out of scope */
-	[[nodiscard ("write_guard blocks other waiters")]] write_guard wait (writer writer);
+	/** Blocks until we are at the head of the queue and blocks other waiters until write_guard goes out of scope. Empty `tables` conflicts with every other writer */
+	[[nodiscard ("write_guard blocks other waiters")]] write_guard wait (writer writer, std::vector<nano::tables> const & tables = {});
 
 	/** Returns true if this writer is anywhere in the queue. Currently only used in tests */
 	bool contains (writer writer) const;
@@ -66,13 +72,23 @@ public:
 	void pop ();
 
 private:
-	void acquire (writer writer);
+	class entry
+	{
+	public:
+		writer type;
+		std::vector<nano::tables> tables;
+	};
+
+	void acquire (writer writer, std::vector<nano::tables> const & tables);
 	void release (writer writer);
+	bool conflicts (entry const &, entry const &) const;
+	bool granted (std::deque<entry>::const_iterator) const;
 
 private:
 	bool const use_noops;
+	bool const table_scoped;
 
-	std::deque<writer> queue;
+	std::deque<entry> queue;
 	mutable nano::mutex mutex;
 	nano::condition_variable condition;
 